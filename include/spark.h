@@ -60,6 +60,16 @@ CSparkMintMeta getMetadata(const spark::Coin& coin, const spark::IncomingViewKey
 spark::InputCoinData getInputData(spark::Coin coin, const spark::FullViewKey& full_view_key, const spark::IncomingViewKey& incoming_view_key);
 spark::InputCoinData getInputData(std::pair<spark::Coin, CSparkMintMeta> coin, const spark::FullViewKey& full_view_key);
 spark::IdentifiedCoinData identifyCoin(spark::Coin coin, const spark::IncomingViewKey& incoming_view_key);
+// Identify a batch of coins across threads (0 for one per core), returning metadata for those belonging to the key in input order
+std::vector<CSparkMintMeta> identifyCoins(const std::vector<spark::Coin>& coins, const spark::IncomingViewKey& incoming_view_key, std::size_t threads = 0);
+// As above, with a key prepared once for the wallet's diversifiers
+std::vector<CSparkMintMeta> identifyCoins(const std::vector<spark::Coin>& coins, const spark::PreparedIncomingViewKey& incoming_view_key, std::size_t threads = 0);
+// As above, over serialized coins and their serial contexts; only coins whose key commitment matches are decoded, and malformed encodings are skipped
+std::vector<CSparkMintMeta> identifyCoins(const std::vector<std::vector<unsigned char>>& serialized_coins, const std::vector<std::vector<unsigned char>>& serial_contexts, const spark::PreparedIncomingViewKey& incoming_view_key, std::size_t threads = 0);
+
+// Threads used to prove spends in createSparkSpendTransaction and getSparkSpendScripts, counting the calling thread
+// (0 for one per core, the default; 1 to prove on the calling thread alone)
+void setSparkProverThreads(std::size_t threads);
 
 std::vector<CRecipient> createSparkMintRecipients(const std::vector<spark::MintedCoinData>& outputs, const std::vector<unsigned char>& serial_context, bool generate);
 
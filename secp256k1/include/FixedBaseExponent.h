@@ -0,0 +1,32 @@
+#ifndef SECP_FIXEDBASEEXPONENT_H
+#define SECP_FIXEDBASEEXPONENT_H
+
+#include <vector>
+#include <cstdint>
+#include "../include/GroupElement.h"
+#include "../include/Scalar.h"
+
+namespace secp_primitives {
+
+// Multiplication by a fixed base point using precomputed windowed tables.
+// The table holds j*16^i*base for every 4-bit window i and digit j, so a
+// multiplication is one mixed addition per nonzero digit and no doublings.
+class FixedBaseExponent {
+public:
+    explicit FixedBaseExponent(const GroupElement& base);
+
+    const GroupElement& get_base() const;
+    GroupElement get_multiple(const Scalar& power) const;
+
+    static constexpr unsigned int window_bits = 4;
+    static constexpr unsigned int window_size = (1 << window_bits) - 1; // digit zero is not stored
+    static constexpr unsigned int windows = 256 / window_bits;
+
+private:
+    GroupElement base_;
+    std::vector<uint64_t> table_; // secp256k1_ge_storage[windows * window_size]
+};
+
+}// namespace secp_primitives
+
+#endif //SECP_FIXEDBASEEXPONENT_H
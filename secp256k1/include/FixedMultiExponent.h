@@ -0,0 +1,33 @@
+#ifndef SECP_FIXEDMULTIEXPONENT_H
+#define SECP_FIXEDMULTIEXPONENT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../include/GroupElement.h"
+#include "../include/Scalar.h"
+
+namespace secp_primitives {
+
+// Multiexponentiation over a generator vector that is fixed for the lifetime of
+// the object. The generators are stored affine together with 2^128 times each
+// generator, so a scalar splits into two 128-bit halves without the endomorphism
+// and the table is fed to Pippenger's algorithm as it is.
+class FixedMultiExponent {
+public:
+    explicit FixedMultiExponent(const std::vector<GroupElement>& generators);
+
+    std::size_t size() const;
+
+    // Computes sum(generators[i] * powers[i]) over the first powers.size() generators
+    GroupElement get_multiple(const std::vector<Scalar>& powers) const;
+    GroupElement get_multiple(const Scalar* powers, std::size_t n_powers) const;
+
+private:
+    std::size_t n_points;
+    std::vector<uint64_t> table_; // secp256k1_ge[]
+};
+
+}// namespace secp_primitives
+
+#endif //SECP_FIXEDMULTIEXPONENT_H
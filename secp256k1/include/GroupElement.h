@@ -21,15 +21,20 @@ public:
 
   GroupElement();
 
-  ~GroupElement();
+  ~GroupElement() = default;
 
-  GroupElement(const GroupElement& other);
+  // The point is stored inline, so copies and moves are plain memory copies
+  GroupElement(const GroupElement& other) = default;
+
+  GroupElement(GroupElement&& other) noexcept = default;
 
   GroupElement(const char* x,const char* y,  int base = 10);
 
   GroupElement& set(const GroupElement& other);
 
-  GroupElement& operator=(const GroupElement& other);
+  GroupElement& operator=(const GroupElement& other) = default;
+
+  GroupElement& operator=(GroupElement&& other) noexcept = default;
 
   // Operator for multiplying with a scalar number.
   GroupElement operator*(const Scalar& multiplier) const;
@@ -52,6 +57,16 @@ public:
 
   bool isInfinity() const;
 
+  // Converts the point to affine coordinates in place and remembers it, so that
+  // serialization and hashing no longer need a field inversion
+  GroupElement& normalize();
+
+  bool isNormalized() const;
+
+  // Normalizes all elements using a single field inversion
+  static void batch_normalize(std::vector<GroupElement>& elements);
+  static void batch_normalize(GroupElement* elements, std::size_t size);
+
 
   bool operator==(const GroupElement&other) const;
 
@@ -110,6 +125,8 @@ public:
   GroupElement& set_base_g();
 
   friend class MultiExponent;
+  friend class FixedBaseExponent;
+  friend class FixedMultiExponent;
 private:
     // Returns the secp object inside it.
     const void * get_value() const;
@@ -117,7 +134,14 @@ private:
     GroupElement(const void *g);
 
 private:
-    void *g_; // secp256k1_gej
+    // Large enough for a secp256k1_gej with either field implementation;
+    // the exact size is checked in GroupElement.cpp
+    static constexpr std::size_t storage_size = 128;
+
+    alignas(8) unsigned char g_[storage_size]; // secp256k1_gej
+
+    // Set when z is one and x, y are fully normalized
+    bool normalized_;
 
 };
 
@@ -1,24 +1,54 @@
 #ifndef SECP_MULTIEXPONENT_H
 #define SECP_MULTIEXPONENT_H
 
+#include <cstddef>
 #include <vector>
 #include "../include/GroupElement.h"
 #include "../include/Scalar.h"
 
 namespace secp_primitives {
 
+// Computes sum(generators[i] * powers[i]).
+// The inputs are read in place rather than copied, so they must outlive the MultiExponent.
 class MultiExponent {
 public:
-    MultiExponent(const MultiExponent& other);
+    MultiExponent(const MultiExponent& other) = default;
     MultiExponent(const std::vector<GroupElement>& generators, const std::vector<Scalar>& powers);
-    ~MultiExponent();
+    MultiExponent(const GroupElement* generators, const Scalar* powers, std::size_t n_points);
 
-    GroupElement get_multiple();
+    // With n_threads > 1, large inputs are split into point ranges that are
+    // multiplied on separate threads and then summed
+    GroupElement get_multiple(std::size_t n_threads = 1) const;
+
+    // Computes the sum over points [begin, end) only, so callers with their own
+    // thread pool can split the work into ranges and add the results
+    GroupElement get_partial_multiple(std::size_t begin, std::size_t end) const;
+
+    // Number of ranges worth splitting n_points into for at most n_threads threads
+    static std::size_t split_count(std::size_t n_points, std::size_t n_threads);
+
+    // Computes sum(generators[i] * powers[k][i]) for every power vector k. The
+    // generators are converted to affine form (and split by the endomorphism) once
+    // and shared by all power vectors instead of once per multiexponentiation.
+    static std::vector<GroupElement> get_multiples(
+        const std::vector<GroupElement>& generators,
+        const std::vector<std::vector<Scalar>>& powers);
+    // As above, with n_vectors power vectors stored one after another in powers
+    static std::vector<GroupElement> get_multiples(
+        const GroupElement* generators,
+        std::size_t n_points,
+        const Scalar* powers,
+        std::size_t n_vectors);
 
 private:
-    void  *sc_; // secp256k1_scalar[]
-    void  *pt_; // secp256k1_gej[]
-    int n_points;
+    static std::vector<GroupElement> get_multiples(
+        const GroupElement* generators,
+        std::size_t n_points,
+        const std::vector<const Scalar*>& powers);
+
+    const GroupElement* pt_;
+    const Scalar* sc_;
+    std::size_t n_points;
 };
 
 }// namespace secp_primitives
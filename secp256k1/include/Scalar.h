@@ -20,16 +20,21 @@ public:
     // Constructor from integer.
     Scalar(uint64_t value);
 
-    // Copy constructor
-    Scalar(const Scalar& other);
+    // The value is stored inline, so copies and moves are plain memory copies
+    Scalar(const Scalar& other) = default;
+
+    Scalar(Scalar&& other) noexcept = default;
 
     Scalar(const unsigned char* str);
 
+    // Wipes the value, since scalars frequently hold secrets
     ~Scalar();
 
     Scalar& set(const Scalar& other);
 
-    Scalar& operator=(const Scalar& other);
+    Scalar& operator=(const Scalar& other) = default;
+
+    Scalar& operator=(Scalar&& other) noexcept = default;
 
     Scalar& operator=(unsigned int i);
 
@@ -52,6 +57,11 @@ public:
 
     Scalar inverse() const;
 
+    // Inverts all scalars in place using a single inversion (Montgomery's trick).
+    // Zero scalars are left as zero, as with inverse().
+    static void batch_invert(std::vector<Scalar>& scalars);
+    static void batch_invert(Scalar* scalars, size_t size);
+
     Scalar negate() const;
 
     Scalar square() const;
@@ -120,7 +130,11 @@ private:
     Scalar(const void *value);
 
 private:
-    void *value_; // secp256k1_scalar
+    // Large enough for a secp256k1_scalar with any scalar implementation;
+    // the exact size is checked in Scalar.cpp
+    static constexpr size_t storage_size = 32;
+
+    alignas(8) unsigned char value_[storage_size]; // secp256k1_scalar
 
 };
 
@@ -0,0 +1,70 @@
+#include "../include/FixedBaseExponent.h"
+
+#include "../include/secp256k1.h"
+#include "../field.h"
+#include "../field_impl.h"
+#include "../group.h"
+#include "../group_impl.h"
+#include "../scalar.h"
+#include "../scalar_impl.h"
+
+#include <stdexcept>
+
+namespace secp_primitives {
+
+static_assert(sizeof(secp256k1_ge_storage) % sizeof(uint64_t) == 0, "secp256k1_ge_storage must fit in uint64_t words");
+
+FixedBaseExponent::FixedBaseExponent(const GroupElement& base)
+        : base_(base)
+{
+    if (base.isInfinity()) {
+        throw std::invalid_argument("FixedBaseExponent: base is infinity");
+    }
+
+    // Row i holds 1*B_i, ..., 15*B_i where B_i = 16^i * base
+    std::vector<secp256k1_gej> points(windows * window_size);
+    secp256k1_gej row_base = *reinterpret_cast<const secp256k1_gej *>(base.get_value());
+    for (unsigned int i = 0; i < windows; i++) {
+        secp256k1_gej *row = &points[i * window_size];
+        row[0] = row_base;
+        for (unsigned int j = 1; j < window_size; j++) {
+            secp256k1_gej_add_var(&row[j], &row[j - 1], &row_base, NULL);
+        }
+        secp256k1_gej_add_var(&row_base, &row[window_size - 1], &row_base, NULL);
+    }
+
+    // Store everything affine, sharing a single inversion
+    std::vector<secp256k1_ge> affine(points.size());
+    secp256k1_ge_set_all_gej_var(affine.data(), points.data(), points.size(), NULL);
+
+    table_.resize(points.size() * sizeof(secp256k1_ge_storage) / sizeof(uint64_t));
+    auto table = reinterpret_cast<secp256k1_ge_storage *>(table_.data());
+    for (std::size_t i = 0; i < affine.size(); i++) {
+        secp256k1_ge_to_storage(&table[i], &affine[i]);
+    }
+}
+
+const GroupElement& FixedBaseExponent::get_base() const {
+    return base_;
+}
+
+GroupElement FixedBaseExponent::get_multiple(const Scalar& power) const {
+    auto sc = reinterpret_cast<const secp256k1_scalar *>(power.get_value());
+    auto table = reinterpret_cast<const secp256k1_ge_storage *>(table_.data());
+
+    secp256k1_gej r;
+    secp256k1_gej_set_infinity(&r);
+    secp256k1_ge ge;
+    for (unsigned int i = 0; i < windows; i++) {
+        unsigned int digit = secp256k1_scalar_get_bits(sc, i * window_bits, window_bits);
+        if (digit == 0) {
+            continue;
+        }
+        secp256k1_ge_from_storage(&ge, &table[i * window_size + digit - 1]);
+        secp256k1_gej_add_ge_var(&r, &r, &ge, NULL);
+    }
+
+    return &r;
+}
+
+}// namespace secp_primitives
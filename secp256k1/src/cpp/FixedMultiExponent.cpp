@@ -0,0 +1,108 @@
+#include "../include/FixedMultiExponent.h"
+
+#include "../include/secp256k1.h"
+#include "../field.h"
+#include "../field_impl.h"
+#include "../group.h"
+#include "../group_impl.h"
+#include "../scalar.h"
+#include "../scalar_impl.h"
+#include "../ecmult.h"
+#include "../ecmult_impl.h"
+#include "../src/scratch_impl.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace secp_primitives {
+
+// Pippenger's wNAF covers WNAF_BITS per scalar, so with the endomorphism enabled
+// each generator is stored twice: as itself and shifted by 2^128
+#ifdef USE_ENDOMORPHISM
+static const std::size_t POINTS_PER_GENERATOR = 2;
+#else
+static const std::size_t POINTS_PER_GENERATOR = 1;
+#endif
+
+FixedMultiExponent::FixedMultiExponent(const std::vector<GroupElement>& generators)
+        : n_points(generators.size())
+{
+    if (n_points == 0) {
+        return;
+    }
+
+    std::vector<secp256k1_gej> points(n_points * POINTS_PER_GENERATOR);
+    for (std::size_t i = 0; i < n_points; i++) {
+        secp256k1_gej g = *reinterpret_cast<const secp256k1_gej *>(generators[i].get_value());
+        points[i * POINTS_PER_GENERATOR] = g;
+#ifdef USE_ENDOMORPHISM
+        for (int j = 0; j < 128; j++) {
+            secp256k1_gej_double_var(&g, &g, NULL);
+        }
+        points[i * POINTS_PER_GENERATOR + 1] = g;
+#endif
+    }
+
+    table_.resize((points.size() * sizeof(secp256k1_ge) + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    secp256k1_ge_set_all_gej_var(reinterpret_cast<secp256k1_ge *>(table_.data()), points.data(), points.size(), NULL);
+}
+
+std::size_t FixedMultiExponent::size() const {
+    return n_points;
+}
+
+GroupElement FixedMultiExponent::get_multiple(const std::vector<Scalar>& powers) const {
+    return get_multiple(powers.data(), powers.size());
+}
+
+GroupElement FixedMultiExponent::get_multiple(const Scalar* powers, std::size_t n_powers) const {
+    if (n_powers > n_points) {
+        throw std::invalid_argument("FixedMultiExponent: too many powers");
+    }
+
+    secp256k1_gej r;
+    secp256k1_gej_set_infinity(&r);
+    if (n_powers == 0) {
+        return &r;
+    }
+
+    const std::size_t entries = n_powers * POINTS_PER_GENERATOR;
+    std::vector<secp256k1_scalar> scalars(entries);
+    for (std::size_t i = 0; i < n_powers; i++) {
+        const secp256k1_scalar *power = reinterpret_cast<const secp256k1_scalar *>(powers[i].get_value());
+#ifdef USE_ENDOMORPHISM
+        // power = low + 2^128 * high
+        unsigned char bytes[32], half[32];
+        secp256k1_scalar_get_b32(bytes, power);
+        memset(half, 0, 16);
+        memcpy(half + 16, bytes + 16, 16);
+        secp256k1_scalar_set_b32(&scalars[2 * i], half, NULL);
+        memcpy(half + 16, bytes, 16);
+        secp256k1_scalar_set_b32(&scalars[2 * i + 1], half, NULL);
+#else
+        scalars[i] = *power;
+#endif
+    }
+
+    int bucket_window = secp256k1_pippenger_bucket_window(n_powers);
+    std::vector<secp256k1_pippenger_point_state> point_states(entries);
+    std::vector<int> wnaf(entries * WNAF_SIZE(bucket_window + 1));
+    std::vector<secp256k1_gej> buckets(ECMULT_TABLE_SIZE(bucket_window + 2));
+
+    secp256k1_pippenger_state state;
+    state.ps = point_states.data();
+    state.wnaf_na = wnaf.data();
+
+    secp256k1_ecmult_pippenger_wnaf(
+        buckets.data(),
+        bucket_window,
+        &state,
+        &r,
+        scalars.data(),
+        reinterpret_cast<const secp256k1_ge *>(table_.data()),
+        entries);
+
+    return &r;
+}
+
+}// namespace secp_primitives
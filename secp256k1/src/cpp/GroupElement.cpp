@@ -32,6 +32,28 @@ static secp256k1_ge gej_to_ge(const secp256k1_gej &gej)
     return ge;
 }
 
+// Same as above, but skips the inversion for points already known to be affine.
+static secp256k1_ge gej_to_ge(const secp256k1_gej &gej, bool normalized)
+{
+    if (!normalized) {
+        return gej_to_ge(gej);
+    }
+
+    secp256k1_ge ge;
+    ge.x = gej.x;
+    ge.y = gej.y;
+    ge.infinity = gej.infinity;
+    return ge;
+}
+
+// Stores an affine point with z = 1 and normalized coordinates.
+static void gej_set_ge_normalized(secp256k1_gej *gej, const secp256k1_ge *ge)
+{
+    secp256k1_gej_set_ge(gej, ge);
+    secp256k1_fe_normalize_var(&gej->x);
+    secp256k1_fe_normalize_var(&gej->y);
+}
+
 //	Implements the algorithm from:
 //   Indifferentiable Hashing to Barreto-Naehrig Curves
 //    Pierre-Alain Fouque and Mehdi Tibouchi
@@ -159,22 +181,21 @@ static void _negate (uint8_t(&num) [Len])
     }
 }
 
+static_assert(sizeof(secp256k1_gej) <= sizeof(GroupElement) && alignof(secp256k1_gej) <= alignof(GroupElement),
+    "GroupElement storage is too small for secp256k1_gej");
+
 GroupElement::GroupElement()
-        : g_(new secp256k1_gej())
+        : normalized_(false)
 {
     auto g = reinterpret_cast<secp256k1_gej *>(g_);
     secp256k1_gej_clear(g);
     g->infinity = 1;
 }
 
-GroupElement::GroupElement(const GroupElement& other)
-        : g_(new secp256k1_gej(*reinterpret_cast<secp256k1_gej *>(other.g_)))
-{
-}
-
 GroupElement::GroupElement(const void *g)
-        : g_(new secp256k1_gej(*reinterpret_cast<const secp256k1_gej *>(g)))
+        : normalized_(false)
 {
+    *reinterpret_cast<secp256k1_gej *>(g_) = *reinterpret_cast<const secp256k1_gej *>(g);
 }
 
 static void _convertToFieldElement(secp256k1_fe *r, const char* str, int base) {
@@ -225,7 +246,6 @@ static void _convertToFieldElement(secp256k1_fe *r, const char* str, int base) {
 }
 
 GroupElement::GroupElement(const char* x,const char* y, int base)
-        : g_(new secp256k1_gej())
 {
     auto g = reinterpret_cast<secp256k1_gej *>(g_);
 
@@ -234,22 +254,14 @@ GroupElement::GroupElement(const char* x,const char* y, int base)
     _convertToFieldElement(&element.x,x,base);
     _convertToFieldElement(&element.y,y,base);
     element.infinity = 0;
-    secp256k1_gej_set_ge(g,&element);
-}
-
-GroupElement::~GroupElement()
-{
-    delete reinterpret_cast<secp256k1_gej *>(g_);
-}
-
-GroupElement& GroupElement::operator=(const GroupElement &other)
-{
-    return set(other);
+    gej_set_ge_normalized(g,&element);
+    normalized_ = true;
 }
 
 GroupElement& GroupElement::set(const GroupElement &other)
 {
-    *reinterpret_cast<secp256k1_gej *>(g_) = *reinterpret_cast<secp256k1_gej *>(other.g_);
+    *reinterpret_cast<secp256k1_gej *>(g_) = *reinterpret_cast<const secp256k1_gej *>(other.g_);
+    normalized_ = other.normalized_;
     return *this;
 }
 
@@ -258,7 +270,7 @@ GroupElement GroupElement::operator*(const Scalar& multiplier) const
     secp256k1_gej result;
     secp256k1_scalar ng;
     secp256k1_scalar_set_int(&ng,0);
-    secp256k1_ecmult(&ctx,&result,reinterpret_cast<secp256k1_gej *>(g_), reinterpret_cast<const secp256k1_scalar *>(multiplier.get_value()),&ng);
+    secp256k1_ecmult(&ctx,&result,reinterpret_cast<const secp256k1_gej *>(g_), reinterpret_cast<const secp256k1_scalar *>(multiplier.get_value()),&ng);
     return &result;
 }
 
@@ -268,27 +280,29 @@ GroupElement& GroupElement::operator*=(const Scalar& multiplier)
     secp256k1_scalar ng;
     secp256k1_scalar_set_int(&ng,0);
     secp256k1_ecmult(&ctx,g,g, reinterpret_cast<const secp256k1_scalar *>(multiplier.get_value()),&ng);
+    normalized_ = false;
     return *this;
 }
 
 GroupElement GroupElement::operator+(const GroupElement &other) const
 {
     secp256k1_gej result_gej;
-    secp256k1_gej_add_var(&result_gej, reinterpret_cast<secp256k1_gej *>(g_), reinterpret_cast<secp256k1_gej *>(other.g_), NULL);
+    secp256k1_gej_add_var(&result_gej, reinterpret_cast<const secp256k1_gej *>(g_), reinterpret_cast<const secp256k1_gej *>(other.g_), NULL);
     return &result_gej;
 }
 
 GroupElement& GroupElement::operator+=(const GroupElement& other)
 {
     auto g = reinterpret_cast<secp256k1_gej *>(g_);
-    secp256k1_gej_add_var(g, g, reinterpret_cast<secp256k1_gej *>(other.g_), NULL);
+    secp256k1_gej_add_var(g, g, reinterpret_cast<const secp256k1_gej *>(other.g_), NULL);
+    normalized_ = false;
     return *this;
 }
 
 GroupElement GroupElement::inverse() const
 {
     secp256k1_gej result_gej;
-    secp256k1_gej_neg(&result_gej,reinterpret_cast<secp256k1_gej *>(g_));
+    secp256k1_gej_neg(&result_gej,reinterpret_cast<const secp256k1_gej *>(g_));
     return &result_gej;
 }
 
@@ -296,22 +310,39 @@ void GroupElement::square()
 {
     auto g = reinterpret_cast<secp256k1_gej *>(g_);
     secp256k1_gej_double_var(g, g, NULL);
+    normalized_ = false;
 }
 
 bool GroupElement::operator==(const  GroupElement& other) const
 {
-    auto g = reinterpret_cast<secp256k1_gej *>(g_);
-    auto og = reinterpret_cast<secp256k1_gej *>(other.g_);
+    auto g = reinterpret_cast<const secp256k1_gej *>(g_);
+    auto og = reinterpret_cast<const secp256k1_gej *>(other.g_);
 
     if(g->infinity && og->infinity)
         return true;
     if(g->infinity != og->infinity)
         return false;
-    secp256k1_ge this_ge = gej_to_ge(*g);
-    secp256k1_ge other_ge = gej_to_ge(*og);
-    if(!secp256k1_fe_equal(&this_ge.x, &other_ge.x))
+
+    if (normalized_ && other.normalized_) {
+        return secp256k1_fe_equal_var(&g->x, &og->x) && secp256k1_fe_equal_var(&g->y, &og->y);
+    }
+
+    // Compare (X1/Z1^2, Y1/Z1^3) with (X2/Z2^2, Y2/Z2^3) by cross-multiplying,
+    // which avoids the field inversions needed to go to affine coordinates
+    secp256k1_fe z1_2, z2_2, z1_3, z2_3, lhs, rhs;
+    secp256k1_fe_sqr(&z1_2, &g->z);
+    secp256k1_fe_sqr(&z2_2, &og->z);
+
+    secp256k1_fe_mul(&lhs, &g->x, &z2_2);
+    secp256k1_fe_mul(&rhs, &og->x, &z1_2);
+    if(!secp256k1_fe_equal_var(&lhs, &rhs))
         return false;
-    if(!secp256k1_fe_equal(&this_ge.y, &other_ge.y))
+
+    secp256k1_fe_mul(&z1_3, &z1_2, &g->z);
+    secp256k1_fe_mul(&z2_3, &z2_2, &og->z);
+    secp256k1_fe_mul(&lhs, &g->y, &z2_3);
+    secp256k1_fe_mul(&rhs, &og->y, &z1_3);
+    if(!secp256k1_fe_equal_var(&lhs, &rhs))
         return false;
 
     return true;
@@ -324,7 +355,7 @@ bool GroupElement::operator!=(const  GroupElement& other) const
 
 bool GroupElement::isMember() const
 {
-    secp256k1_ge v1 = gej_to_ge(*reinterpret_cast<secp256k1_gej *>(g_));
+    secp256k1_ge v1 = gej_to_ge(*reinterpret_cast<const secp256k1_gej *>(g_), normalized_);
     if (secp256k1_ge_is_infinity(&v1)) {
         return true;
     }
@@ -336,6 +367,59 @@ bool GroupElement::isInfinity() const
     return secp256k1_gej_is_infinity(reinterpret_cast<const secp256k1_gej *>(g_));
 }
 
+GroupElement& GroupElement::normalize()
+{
+    auto g = reinterpret_cast<secp256k1_gej *>(g_);
+    if (normalized_ || g->infinity) {
+        return *this;
+    }
+
+    secp256k1_ge ge;
+    secp256k1_ge_set_gej_var(&ge, g);
+    gej_set_ge_normalized(g, &ge);
+    normalized_ = true;
+    return *this;
+}
+
+bool GroupElement::isNormalized() const
+{
+    return normalized_;
+}
+
+void GroupElement::batch_normalize(std::vector<GroupElement>& elements)
+{
+    batch_normalize(elements.data(), elements.size());
+}
+
+void GroupElement::batch_normalize(GroupElement* elements, std::size_t size)
+{
+    // Infinity has no affine form, so it is left as it is
+    std::vector<std::size_t> indexes;
+    std::vector<secp256k1_gej> gej;
+    indexes.reserve(size);
+    gej.reserve(size);
+    for (std::size_t i = 0; i < size; i++) {
+        auto g = reinterpret_cast<const secp256k1_gej *>(elements[i].g_);
+        if (!elements[i].normalized_ && !g->infinity) {
+            indexes.emplace_back(i);
+            gej.emplace_back(*g);
+        }
+    }
+
+    if (gej.empty()) {
+        return;
+    }
+
+    std::vector<secp256k1_ge> ge(gej.size());
+    secp256k1_ge_set_all_gej_var(ge.data(), gej.data(), gej.size(), NULL);
+
+    for (std::size_t i = 0; i < indexes.size(); i++) {
+        GroupElement& element = elements[indexes[i]];
+        gej_set_ge_normalized(reinterpret_cast<secp256k1_gej *>(element.g_), &ge[i]);
+        element.normalized_ = true;
+    }
+}
+
 void GroupElement::randomize() {
     unsigned char temp[32] = { 0 };
 
@@ -383,7 +467,8 @@ GroupElement& GroupElement::generate(unsigned char* seed){
     if (gen[0] & 1) {
         secp256k1_ge_neg(&ge, &ge);
     }
-    secp256k1_gej_set_ge(reinterpret_cast<secp256k1_gej *>(g_), &ge);
+    gej_set_ge_normalized(reinterpret_cast<secp256k1_gej *>(g_), &ge);
+    normalized_ = true;
     return *this;
 }
 
@@ -396,7 +481,7 @@ void GroupElement::normalSha256(unsigned char* result) const {
 }
 
 void GroupElement::sha256(unsigned char* result) const {
-    auto g = reinterpret_cast<secp256k1_gej *>(g_);
+    auto g = reinterpret_cast<const secp256k1_gej *>(g_);
     unsigned char buff[64];
     secp256k1_fe_get_b32(&buff[0], &g->x);
     secp256k1_fe_get_b32(&buff[32], &g->y);
@@ -455,7 +540,7 @@ std::string _convertToString(const unsigned char(&buffer) [Len], int base) {
 
 std::string GroupElement::tostring() const {
     int base = 10;
-    secp256k1_ge ge = gej_to_ge(*reinterpret_cast<secp256k1_gej *>(g_));
+    secp256k1_ge ge = gej_to_ge(*reinterpret_cast<const secp256k1_gej *>(g_), normalized_);
 
     if (ge.infinity) {
     return std::string("O");
@@ -477,7 +562,7 @@ std::string GroupElement::tostring() const {
 
 std::string GroupElement::GetHex() const {
     int base = 16;
-    secp256k1_ge ge = gej_to_ge(*reinterpret_cast<secp256k1_gej *>(g_));
+    secp256k1_ge ge = gej_to_ge(*reinterpret_cast<const secp256k1_gej *>(g_), normalized_);
 
     if (ge.infinity) {
         return std::string("O");
@@ -498,7 +583,7 @@ std::string GroupElement::GetHex() const {
 }
 
 unsigned char* GroupElement::serialize() const {
-    auto g = reinterpret_cast<secp256k1_gej *>(g_);
+    auto g = reinterpret_cast<const secp256k1_gej *>(g_);
     unsigned char* data = new unsigned char[ 2 * sizeof(secp256k1_fe)];
     memcpy(&data[0], &g->x.n[0], sizeof(secp256k1_fe));
     memcpy(&data[0] + sizeof(secp256k1_fe), &g->y.n[0], sizeof(secp256k1_fe));
@@ -506,7 +591,7 @@ unsigned char* GroupElement::serialize() const {
 }
 
 unsigned char* GroupElement::serialize(unsigned char* buffer) const {
-    secp256k1_ge value = gej_to_ge(*reinterpret_cast<secp256k1_gej *>(g_));
+    secp256k1_ge value = gej_to_ge(*reinterpret_cast<const secp256k1_gej *>(g_), normalized_);
     secp256k1_fe x = value.x;
     secp256k1_fe y = value.y;
     secp256k1_fe_normalize(&x);
@@ -528,7 +613,13 @@ const unsigned char* GroupElement::deserialize(const unsigned char* buffer) {
     secp256k1_ge_set_xo_var(&result, &x, (int)oddness);
     result.infinity = (int)infinity;
 
-    secp256k1_gej_set_ge(reinterpret_cast<secp256k1_gej *>(g_), &result);
+    if (result.infinity) {
+        secp256k1_gej_set_ge(reinterpret_cast<secp256k1_gej *>(g_), &result);
+        normalized_ = false;
+    } else {
+        gej_set_ge_normalized(reinterpret_cast<secp256k1_gej *>(g_), &result);
+        normalized_ = true;
+    }
 
     if (!secp256k1_ge_is_valid_var(&result) && !result.infinity) {
         throw std::invalid_argument("GroupElement: deserialize failed");
@@ -546,7 +637,7 @@ std::vector<unsigned char> GroupElement::getvch() const {
 
 std::size_t GroupElement::hash() const
 {
-    auto ge = gej_to_ge(*reinterpret_cast<secp256k1_gej *>(g_));
+    auto ge = gej_to_ge(*reinterpret_cast<const secp256k1_gej *>(g_), normalized_);
     std::array<unsigned char, 32 * 2> coord;
 
     if (ge.infinity) {
@@ -560,7 +651,12 @@ std::size_t GroupElement::hash() const
 }
 
 std::size_t GroupElement::get_hash() const {
-    secp256k1_fe x = reinterpret_cast<secp256k1_gej *>(g_)->x;
+    // Equal points must hash equally, so this has to use the affine x coordinate
+    auto g = reinterpret_cast<const secp256k1_gej *>(g_);
+    if (g->infinity) {
+        return 0;
+    }
+    secp256k1_fe x = gej_to_ge(*g, normalized_).x;
     secp256k1_fe_normalize(&x);
     return x.n[0] ^ (x.n[1] << 16);
 }
@@ -570,7 +666,8 @@ const void* GroupElement::get_value() const {
 }
 
 GroupElement& GroupElement::set_base_g() {
-    secp256k1_gej_set_ge(reinterpret_cast<secp256k1_gej *>(g_), &secp256k1_ge_const_g);
+    gej_set_ge_normalized(reinterpret_cast<secp256k1_gej *>(g_), &secp256k1_ge_const_g);
+    normalized_ = true;
     return *this;
 }
 
@@ -12,73 +12,262 @@
 #include "../src/scratch_impl.h"
 #include "../src/ecmult_impl.h"
 
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+
+using secp_primitives::GroupElement;
+using secp_primitives::Scalar;
 
 typedef struct {
-    secp256k1_scalar *sc;
-    secp256k1_gej *pt;
+    const Scalar *sc;
+    const GroupElement *pt;
 } ecmult_multi_data;
 
+// GroupElement keeps its secp256k1_gej as the first member, so the caller's
+// elements can be read in place
+static_assert(std::is_standard_layout<GroupElement>::value, "GroupElement must be standard layout");
+
 int ecmult_multi_callback(secp256k1_scalar *sc, secp256k1_gej *pt, size_t idx, void *cbdata) {
     ecmult_multi_data *data = (ecmult_multi_data*) cbdata;
-    *sc = data->sc[idx];
-    *pt = data->pt[idx];
+    *sc = *reinterpret_cast<const secp256k1_scalar *>(data->sc[idx].get_value());
+    *pt = *reinterpret_cast<const secp256k1_gej *>(&data->pt[idx]);
     return 1;
 }
 
+// Scratch space owned by the calling thread. The scratch keeps its frame buffers
+// between calls, so repeated multiexponentiations only allocate when they grow.
+struct thread_scratch {
+    secp256k1_scratch *scratch = NULL;
+
+    ~thread_scratch() {
+        secp256k1_scratch_destroy(scratch);
+    }
+};
+
+static secp256k1_scratch *get_thread_scratch(size_t max_size) {
+    thread_local thread_scratch local;
+    if (local.scratch == NULL) {
+        local.scratch = secp256k1_scratch_create(NULL, max_size);
+    }
+    local.scratch->max_size = max_size;
+    return local.scratch;
+}
+
+// Splitting below this many points per thread costs more than it saves
+static const size_t MIN_POINTS_PER_THREAD = 1024;
+
+static void multiexp_range(secp256k1_gej *r, const GroupElement *pt, const Scalar *sc, size_t n_points) {
+    ecmult_multi_data data;
+    data.sc = sc;
+    data.pt = pt;
+
+    size_t scratch_size;
+    if (n_points > ECMULT_PIPPENGER_THRESHOLD) {
+        int bucket_window = secp256k1_pippenger_bucket_window(n_points);
+        scratch_size = secp256k1_pippenger_scratch_size(n_points, bucket_window) + PIPPENGER_SCRATCH_OBJECTS*ALIGNMENT;
+    } else {
+        scratch_size = secp256k1_strauss_scratch_size(n_points) + STRAUSS_SCRATCH_OBJECTS*ALIGNMENT;
+    }
+    secp256k1_scratch *scratch = get_thread_scratch(scratch_size);
+
+    secp256k1_ecmult_context ctx;
+
+    secp256k1_ecmult_multi_var(&ctx, scratch, r, NULL, ecmult_multi_callback, &data, n_points);
+}
+
 namespace secp_primitives {
 
-MultiExponent::MultiExponent(const MultiExponent& other)
-        : sc_(new secp256k1_scalar[other.n_points])
-        , pt_(new secp256k1_gej[other.n_points])
-        , n_points(other.n_points)
+MultiExponent::MultiExponent(const std::vector<GroupElement>& generators, const std::vector<Scalar>& powers)
+        : pt_(generators.data())
+        , sc_(powers.data())
+        , n_points(generators.size())
 {
-    for(int i = 0; i < n_points; ++i)
-    {
-        (reinterpret_cast<secp256k1_scalar *>(sc_))[i] = (reinterpret_cast<secp256k1_scalar *>(other.sc_))[i];
-        (reinterpret_cast<secp256k1_gej *>(pt_))[i] = (reinterpret_cast<secp256k1_gej *>(other.pt_))[i];
+    if (generators.size() != powers.size()) {
+        throw std::invalid_argument("MultiExponent: size mismatch");
     }
 }
 
-MultiExponent::MultiExponent(const std::vector<GroupElement>& generators, const std::vector<Scalar>& powers){
-    sc_ = new secp256k1_scalar[powers.size()];
-    pt_ = new secp256k1_gej[generators.size()];
-    n_points = generators.size();
-    for(int i = 0; i < n_points; ++i)
+MultiExponent::MultiExponent(const GroupElement* generators, const Scalar* powers, std::size_t n_points_)
+        : pt_(generators)
+        , sc_(powers)
+        , n_points(n_points_)
+{
+}
+
+std::size_t MultiExponent::split_count(std::size_t n_points, std::size_t n_threads) {
+    return std::max<std::size_t>(1, std::min(n_threads, n_points / MIN_POINTS_PER_THREAD));
+}
+
+GroupElement MultiExponent::get_partial_multiple(std::size_t begin, std::size_t end) const {
+    if (begin > end || end > n_points) {
+        throw std::invalid_argument("MultiExponent: bad range");
+    }
+    secp256k1_gej r;
+    multiexp_range(&r, pt_ + begin, sc_ + begin, end - begin);
+    return reinterpret_cast<secp256k1_scalar *>(&r);
+}
+
+// Joins every started worker on scope exit, so an exception never leaves a joinable thread behind
+struct thread_join_guard {
+    std::vector<std::thread>& workers;
+
+    ~thread_join_guard() {
+        for (auto& worker : workers) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+};
+
+GroupElement MultiExponent::get_multiple(std::size_t n_threads) const {
+    n_threads = split_count(n_points, n_threads);
+    if (n_threads <= 1) {
+        secp256k1_gej r;
+        multiexp_range(&r, pt_, sc_, n_points);
+        return reinterpret_cast<secp256k1_scalar *>(&r);
+    }
+
+    // Each thread handles one contiguous range with its own scratch space
+    std::vector<secp256k1_gej> partial(n_threads);
+    std::vector<std::thread> workers;
+    workers.reserve(n_threads - 1);
+    std::size_t chunk = (n_points + n_threads - 1) / n_threads;
     {
-        (reinterpret_cast<secp256k1_scalar *>(sc_))[i] = *reinterpret_cast<const secp256k1_scalar *>(powers[i].get_value());
-        (reinterpret_cast<secp256k1_gej *>(pt_))[i] = *reinterpret_cast<const secp256k1_gej *>(generators[i].get_value());
+        thread_join_guard guard{workers};
+        for (std::size_t t = 1; t < n_threads; t++) {
+            std::size_t start = std::min(t * chunk, n_points);
+            std::size_t size = std::min(chunk, n_points - start);
+            try {
+                workers.emplace_back(multiexp_range, &partial[t], pt_ + start, sc_ + start, size);
+            } catch (const std::system_error&) {
+                // Out of threads; do this range here instead
+                multiexp_range(&partial[t], pt_ + start, sc_ + start, size);
+            }
+        }
+        multiexp_range(&partial[0], pt_, sc_, chunk);
+    }
+
+    secp256k1_gej r = partial[0];
+    for (std::size_t t = 1; t < n_threads; t++) {
+        secp256k1_gej_add_var(&r, &r, &partial[t], NULL);
     }
+    return reinterpret_cast<secp256k1_scalar *>(&r);
 }
 
-MultiExponent::~MultiExponent(){
-    delete []reinterpret_cast<secp256k1_scalar *>(sc_);
-    delete []reinterpret_cast<secp256k1_gej *>(pt_);
+std::vector<GroupElement> MultiExponent::get_multiples(
+        const std::vector<GroupElement>& generators,
+        const std::vector<std::vector<Scalar>>& powers) {
+    std::vector<const Scalar *> rows;
+    rows.reserve(powers.size());
+    for (const auto& p : powers) {
+        if (p.size() != generators.size()) {
+            throw std::invalid_argument("MultiExponent: size mismatch");
+        }
+        rows.push_back(p.data());
+    }
+    return get_multiples(generators.data(), generators.size(), rows);
 }
 
-GroupElement MultiExponent::get_multiple() {
-    secp256k1_gej r;
+std::vector<GroupElement> MultiExponent::get_multiples(
+        const GroupElement* generators,
+        std::size_t n_points,
+        const Scalar* powers,
+        std::size_t n_vectors) {
+    std::vector<const Scalar *> rows;
+    rows.reserve(n_vectors);
+    for (size_t k = 0; k < n_vectors; k++) {
+        rows.push_back(powers + k * n_points);
+    }
+    return get_multiples(generators, n_points, rows);
+}
 
-    ecmult_multi_data data;
-    data.sc = reinterpret_cast<secp256k1_scalar *>(sc_);
-    data.pt = reinterpret_cast<secp256k1_gej *>(pt_);
+std::vector<GroupElement> MultiExponent::get_multiples(
+        const GroupElement* generators,
+        std::size_t n,
+        const std::vector<const Scalar*>& powers) {
+    std::vector<GroupElement> result;
+    result.reserve(powers.size());
 
-    secp256k1_scratch *scratch;
-    if (n_points > ECMULT_PIPPENGER_THRESHOLD) {
-        int bucket_window = secp256k1_pippenger_bucket_window(n_points);
-        size_t scratch_size = secp256k1_pippenger_scratch_size(n_points, bucket_window);
-        scratch = secp256k1_scratch_create(NULL, scratch_size + PIPPENGER_SCRATCH_OBJECTS*ALIGNMENT);
-    } else {
-        size_t scratch_size = secp256k1_strauss_scratch_size(n_points);
-        scratch = secp256k1_scratch_create(NULL, scratch_size + STRAUSS_SCRATCH_OBJECTS*ALIGNMENT);
+    // Below the Pippenger threshold there is no shared work worth doing
+    if (n < ECMULT_PIPPENGER_THRESHOLD) {
+        for (const Scalar* p : powers) {
+            result.push_back(MultiExponent(generators, p, n).get_multiple());
+        }
+        return result;
     }
 
-    secp256k1_ecmult_context ctx;
+#ifdef USE_ENDOMORPHISM
+    const size_t entries = 2 * n;
+#else
+    const size_t entries = n;
+#endif
 
-    secp256k1_ecmult_multi_var(&ctx, scratch, &r, NULL, ecmult_multi_callback, &data, n_points);
+    // Shared affine bases, with lambda * G_i following each G_i when using the endomorphism
+    std::vector<secp256k1_ge> bases(entries);
+    {
+        std::vector<secp256k1_gej> gej(n);
+        for (size_t i = 0; i < n; i++) {
+            gej[i] = *reinterpret_cast<const secp256k1_gej *>(&generators[i]);
+        }
+#ifdef USE_ENDOMORPHISM
+        std::vector<secp256k1_ge> ge(n);
+        secp256k1_ge_set_all_gej_var(ge.data(), gej.data(), n, NULL);
+        for (size_t i = 0; i < n; i++) {
+            bases[2 * i] = ge[i];
+            secp256k1_ge_mul_lambda(&bases[2 * i + 1], &ge[i]);
+        }
+#else
+        secp256k1_ge_set_all_gej_var(bases.data(), gej.data(), n, NULL);
+#endif
+    }
+
+    // Working space reused across the power vectors
+    int bucket_window = secp256k1_pippenger_bucket_window(n);
+    std::vector<secp256k1_ge> points(entries);
+    std::vector<secp256k1_scalar> scalars(entries);
+    std::vector<secp256k1_pippenger_point_state> point_states(entries);
+    std::vector<int> wnaf(entries * WNAF_SIZE(bucket_window + 1));
+    std::vector<secp256k1_gej> buckets(ECMULT_TABLE_SIZE(bucket_window + 2));
+    secp256k1_pippenger_state state;
+    state.ps = point_states.data();
+    state.wnaf_na = wnaf.data();
+
+    for (const Scalar* p : powers) {
+        for (size_t i = 0; i < n; i++) {
+            const secp256k1_scalar *power = reinterpret_cast<const secp256k1_scalar *>(p[i].get_value());
+#ifdef USE_ENDOMORPHISM
+            // Same split as secp256k1_ecmult_endo_split, applied to the shared bases
+            secp256k1_scalar_split_lambda(&scalars[2 * i], &scalars[2 * i + 1], power);
+            for (size_t j = 2 * i; j < 2 * i + 2; j++) {
+                points[j] = bases[j];
+                if (secp256k1_scalar_is_high(&scalars[j])) {
+                    secp256k1_scalar_negate(&scalars[j], &scalars[j]);
+                    secp256k1_ge_neg(&points[j], &points[j]);
+                }
+            }
+#else
+            scalars[i] = *power;
+            points[i] = bases[i];
+#endif
+        }
 
-    secp256k1_scratch_destroy(scratch);
+        secp256k1_gej r;
+        secp256k1_ecmult_pippenger_wnaf(buckets.data(), bucket_window, &state, &r, scalars.data(), points.data(), entries);
+        result.push_back(GroupElement(&r));
+    }
+
+    // Clear data derived from the powers
+    for (size_t i = 0; i < entries; i++) {
+        secp256k1_scalar_clear(&scalars[i]);
+        point_states[i].skew_na = 0;
+    }
+    std::fill(wnaf.begin(), wnaf.end(), 0);
 
-    return  reinterpret_cast<secp256k1_scalar *>(&r);
+    return result;
 }
 
 }// namespace secp_primitives
@@ -14,17 +14,19 @@
 #include <array>
 #include <sstream>
 #include <iostream>
+#include <openssl/crypto.h>
 #include <openssl/rand.h>
 
 namespace secp_primitives {
 
-Scalar::Scalar()
-   : value_(new secp256k1_scalar()) {
+static_assert(sizeof(secp256k1_scalar) <= sizeof(Scalar) && alignof(secp256k1_scalar) <= alignof(Scalar),
+    "Scalar storage is too small for secp256k1_scalar");
+
+Scalar::Scalar() {
     secp256k1_scalar_clear(reinterpret_cast<secp256k1_scalar *>(value_));
 }
 
-Scalar::Scalar(uint64_t value)
-   : value_(new secp256k1_scalar()) {
+Scalar::Scalar(uint64_t value) {
     unsigned char b32[32];
     for(int i = 0; i < 24; i++)
         b32[i] = 0;
@@ -39,27 +41,16 @@ Scalar::Scalar(uint64_t value)
     secp256k1_scalar_set_b32(reinterpret_cast<secp256k1_scalar *>(value_), b32, 0);
 }
 
-Scalar::Scalar(const unsigned char* str)
-     : value_(new secp256k1_scalar()) {
+Scalar::Scalar(const unsigned char* str) {
     secp256k1_scalar_set_b32(reinterpret_cast<secp256k1_scalar *>(value_), str, 0);
 }
 
-Scalar::Scalar(const void *value)
-   : value_(new secp256k1_scalar(*reinterpret_cast<const secp256k1_scalar *>(value))) {
-
-}
-
-Scalar::Scalar(const Scalar& other)
-   : value_(new secp256k1_scalar(*reinterpret_cast<const secp256k1_scalar *>(other.value_))) {
-
+Scalar::Scalar(const void *value) {
+    *reinterpret_cast<secp256k1_scalar *>(value_) = *reinterpret_cast<const secp256k1_scalar *>(value);
 }
 
 Scalar::~Scalar() {
-    delete reinterpret_cast<secp256k1_scalar *>(value_);
-}
-
-Scalar& Scalar::operator=(const Scalar& other) {
-    return set(other);
+    OPENSSL_cleanse(value_, sizeof(value_));
 }
 
 Scalar& Scalar::operator=(unsigned int i) {
@@ -144,6 +135,40 @@ Scalar Scalar::inverse() const {
  return &result;
 }
 
+void Scalar::batch_invert(std::vector<Scalar>& scalars) {
+    batch_invert(scalars.data(), scalars.size());
+}
+
+void Scalar::batch_invert(Scalar* scalars, size_t size) {
+    // prefix[i] is the product of all nonzero scalars before index i
+    std::vector<secp256k1_scalar> prefix(size);
+    secp256k1_scalar acc;
+    secp256k1_scalar_set_int(&acc, 1);
+    for (size_t i = 0; i < size; i++) {
+        prefix[i] = acc;
+        auto value = reinterpret_cast<const secp256k1_scalar *>(scalars[i].value_);
+        if (!secp256k1_scalar_is_zero(value)) {
+            secp256k1_scalar_mul(&acc, &acc, value);
+        }
+    }
+
+    secp256k1_scalar_inverse(&acc, &acc);
+
+    // Walk back, peeling one scalar off the inverted product at a time
+    for (size_t i = size; i-- > 0;) {
+        auto value = reinterpret_cast<secp256k1_scalar *>(scalars[i].value_);
+        if (secp256k1_scalar_is_zero(value)) {
+            continue;
+        }
+        secp256k1_scalar inverse;
+        secp256k1_scalar_mul(&inverse, &acc, &prefix[i]);
+        secp256k1_scalar_mul(&acc, &acc, value);
+        *value = inverse;
+    }
+
+    OPENSSL_cleanse(prefix.data(), prefix.size() * sizeof(secp256k1_scalar));
+}
+
 Scalar Scalar::negate() const {
     secp256k1_scalar result;
     secp256k1_scalar_negate(&result, reinterpret_cast<const secp256k1_scalar *>(value_));
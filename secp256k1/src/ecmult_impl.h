@@ -845,7 +845,8 @@ static int secp256k1_ecmult_pippenger_batch(const secp256k1_ecmult_context *ctx,
             secp256k1_scratch_deallocate_frame(scratch);
             return 0;
         }
-        secp256k1_ge_set_gej(&points[idx], &point);
+        /* Normalized inputs are already affine and need no inversion */
+        secp256k1_ge_set_gej_affine_var(&points[idx], &point);
         idx++;
 #ifdef USE_ENDOMORPHISM
         secp256k1_ecmult_endo_split(&scalars[idx - 1], &scalars[idx], &points[idx - 1], &points[idx]);
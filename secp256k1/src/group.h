@@ -64,6 +64,9 @@ static void secp256k1_ge_neg(secp256k1_ge *r, const secp256k1_ge *a);
 /** Set a group element equal to another which is given in jacobian coordinates */
 static void secp256k1_ge_set_gej(secp256k1_ge *r, secp256k1_gej *a);
 
+/** Same as secp256k1_ge_set_gej, but skips the inversion when a is already affine (z == 1) */
+static void secp256k1_ge_set_gej_affine_var(secp256k1_ge *r, secp256k1_gej *a);
+
 /** Set a batch of group elements equal to the inputs given in jacobian coordinates */
 static void secp256k1_ge_set_all_gej_var(secp256k1_ge *r, const secp256k1_gej *a, size_t len, const secp256k1_callback *cb);
 
@@ -126,6 +126,19 @@ static void secp256k1_ge_set_gej_var(secp256k1_ge *r, secp256k1_gej *a) {
     r->y = a->y;
 }
 
+static void secp256k1_ge_set_gej_affine_var(secp256k1_ge *r, secp256k1_gej *a) {
+    static const secp256k1_fe one = SECP256K1_FE_CONST(0, 0, 0, 0, 0, 0, 0, 1);
+    if (a->infinity || !secp256k1_fe_equal_var(&one, &a->z)) {
+        secp256k1_ge_set_gej(r, a);
+        return;
+    }
+    r->infinity = 0;
+    r->x = a->x;
+    r->y = a->y;
+    secp256k1_fe_normalize_weak(&r->x);
+    secp256k1_fe_normalize_weak(&r->y);
+}
+
 static void secp256k1_ge_set_all_gej_var(secp256k1_ge *r, const secp256k1_gej *a, size_t len, const secp256k1_callback *cb) {
     secp256k1_fe *az;
     secp256k1_fe *azi;
@@ -1,4 +1,5 @@
 #include "aead.h"
+#include <algorithm>
 
 namespace spark {
 
@@ -48,49 +49,97 @@ AEADEncryptedData AEAD::encrypt(const GroupElement& prekey, const std::string ad
 // NOTE: This uses a fixed zero nonce, which is safe when used in Spark as directed
 // It is NOT safe in general to do this!
 CDataStream AEAD::decrypt_and_verify(const GroupElement& prekey, const std::string additional_data, AEADEncryptedData& data) {
-    // Assert that the key commitment is valid
-    std::vector<unsigned char> key_commitment = SparkUtils::commit_aead(prekey);
-    if (key_commitment != data.key_commitment) {
-        throw std::runtime_error("Bad AEAD key commitment");
-    }
+	AEADDecryptor decryptor;
+	return decryptor.decrypt_and_verify(prekey, additional_data, data);
+}
+
+AEADDecryptor::AEADDecryptor()
+	: commit_prefix(LABEL_COMMIT_AEAD, AEAD_COMMIT_SIZE)
+	, key_prefix(LABEL_KDF_AEAD, AEAD_KEY_SIZE)
+{
+	// The cipher is fixed, so only the key changes between uses
+	this->ctx = EVP_CIPHER_CTX_new();
+	EVP_DecryptInit_ex(this->ctx, EVP_chacha20_poly1305(), NULL, NULL, NULL);
+}
+
+AEADDecryptor::~AEADDecryptor() {
+	EVP_CIPHER_CTX_free(this->ctx);
+}
 
-    // Derive the key
-    std::vector<unsigned char> key = SparkUtils::kdf_aead(prekey);
+CDataStream AEADDecryptor::decrypt_and_verify(const GroupElement& prekey, const std::string& additional_data, const AEADEncryptedData& data) {
+	// The prekey is included in both derivations, so serialize it once
+	CDataStream prekey_stream(SER_NETWORK, PROTOCOL_VERSION);
+	prekey_stream << prekey;
+
+	// Assert that the key commitment is valid
+	if (!check_commitment(prekey_stream, data.key_commitment.data(), data.key_commitment.size())) {
+		throw std::runtime_error("Bad AEAD key commitment");
+	}
+
+	CDataStream result(SER_NETWORK, PROTOCOL_VERSION);
+	if (!decrypt(prekey_stream, additional_data, data, result)) {
+		throw std::runtime_error("Bad AEAD authentication");
+	}
+
+	return result;
+}
+
+bool AEADDecryptor::try_decrypt_and_verify(const GroupElement& prekey, const std::string& additional_data, const AEADEncryptedData& data, CDataStream& result) {
+	CDataStream prekey_stream(SER_NETWORK, PROTOCOL_VERSION);
+	prekey_stream << prekey;
+
+	return check_commitment(prekey_stream, data.key_commitment.data(), data.key_commitment.size()) && decrypt(prekey_stream, additional_data, data, result);
+}
+
+bool AEADDecryptor::check_key_commitment(const GroupElement& prekey, const unsigned char* key_commitment) {
+	CDataStream prekey_stream(SER_NETWORK, PROTOCOL_VERSION);
+	prekey_stream << prekey;
+
+	return check_commitment(prekey_stream, key_commitment, AEAD_COMMIT_SIZE);
+}
 
-    // Set up the result
-    CDataStream result(SER_NETWORK, PROTOCOL_VERSION);
+bool AEADDecryptor::try_decrypt(const GroupElement& prekey, const std::string& additional_data, const AEADEncryptedData& data, CDataStream& result) {
+	CDataStream prekey_stream(SER_NETWORK, PROTOCOL_VERSION);
+	prekey_stream << prekey;
+
+	return decrypt(prekey_stream, additional_data, data, result);
+}
+
+bool AEADDecryptor::check_commitment(CDataStream& prekey_stream, const unsigned char* key_commitment, const std::size_t size) {
+	KDF commit(this->commit_prefix);
+	commit.include(prekey_stream);
+	std::vector<unsigned char> expected = commit.finalize();
+
+	return size == expected.size() && std::equal(expected.begin(), expected.end(), key_commitment);
+}
+
+bool AEADDecryptor::decrypt(CDataStream& prekey_stream, const std::string& additional_data, const AEADEncryptedData& data, CDataStream& result) {
+	// Derive the key
+	KDF kdf(this->key_prefix);
+	kdf.include(prekey_stream);
+	std::vector<unsigned char> key = kdf.finalize();
 
 	// Internal size tracker; we know the size of the data already, and can ignore
 	int TEMP;
 
 	// For our application, we can safely use a zero nonce since keys are never reused
-	std::vector<unsigned char> iv;
-	iv.resize(AEAD_IV_SIZE);
+	unsigned char iv[AEAD_IV_SIZE] = {};
 
-	// Set up the cipher
-	EVP_CIPHER_CTX* ctx;
-	ctx = EVP_CIPHER_CTX_new();
-	EVP_DecryptInit_ex(ctx, EVP_chacha20_poly1305(), NULL, key.data(), iv.data());
+	// Rekey the cipher
+	EVP_DecryptInit_ex(this->ctx, NULL, NULL, key.data(), iv);
 
 	// Include the associated data
-	std::vector<unsigned char> additional_data_bytes(additional_data.begin(), additional_data.end());
-	EVP_DecryptUpdate(ctx, NULL, &TEMP, additional_data_bytes.data(), additional_data_bytes.size());
+	EVP_DecryptUpdate(this->ctx, NULL, &TEMP, reinterpret_cast<const unsigned char *>(additional_data.data()), additional_data.size());
 
 	// Decrypt the ciphertext
 	result.resize(data.ciphertext.size());
-	EVP_DecryptUpdate(ctx, reinterpret_cast<unsigned char *>(result.data()), &TEMP, data.ciphertext.data(), data.ciphertext.size());
-	
-	// Set the expected tag
-	EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, AEAD_TAG_SIZE, data.tag.data());
+	EVP_DecryptUpdate(this->ctx, reinterpret_cast<unsigned char *>(result.data()), &TEMP, data.ciphertext.data(), data.ciphertext.size());
 
-	// Decrypt and clean up
-	int ret = EVP_DecryptFinal_ex(ctx, NULL, &TEMP);
-	EVP_CIPHER_CTX_free(ctx);
-	if (ret != 1) {
-		throw std::runtime_error("Bad AEAD authentication");
-	}
+	// Set the expected tag
+	EVP_CIPHER_CTX_ctrl(this->ctx, EVP_CTRL_AEAD_SET_TAG, AEAD_TAG_SIZE, const_cast<unsigned char *>(data.tag.data()));
 
-	return result;
+	// Decrypt
+	return EVP_DecryptFinal_ex(this->ctx, NULL, &TEMP) == 1;
 }
 
 }
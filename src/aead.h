@@ -36,6 +36,35 @@ public:
 	static CDataStream decrypt_and_verify(const GroupElement& prekey, const std::string associated_data, AEADEncryptedData& data);
 };
 
+// Decryption state reused across many ciphertexts, such as when scanning coins
+// The labeled KDF prefixes and the cipher context are set up once; an instance must not be shared between threads
+class AEADDecryptor {
+public:
+	AEADDecryptor();
+	~AEADDecryptor();
+	AEADDecryptor(const AEADDecryptor&) = delete;
+	AEADDecryptor& operator=(const AEADDecryptor&) = delete;
+
+	CDataStream decrypt_and_verify(const GroupElement& prekey, const std::string& associated_data, const AEADEncryptedData& data);
+
+	// As above, but reports a key commitment or authentication failure by returning false instead of throwing
+	bool try_decrypt_and_verify(const GroupElement& prekey, const std::string& associated_data, const AEADEncryptedData& data, CDataStream& result);
+
+	// Check only the key commitment (AEAD_COMMIT_SIZE bytes), which rejects a wrong prekey without decrypting
+	bool check_key_commitment(const GroupElement& prekey, const unsigned char* key_commitment);
+
+	// As try_decrypt_and_verify, for a prekey already checked against the data's key commitment
+	bool try_decrypt(const GroupElement& prekey, const std::string& associated_data, const AEADEncryptedData& data, CDataStream& result);
+
+private:
+	bool check_commitment(CDataStream& prekey_stream, const unsigned char* key_commitment, const std::size_t size);
+	bool decrypt(CDataStream& prekey_stream, const std::string& associated_data, const AEADEncryptedData& data, CDataStream& result);
+
+	KDF commit_prefix;
+	KDF key_prefix;
+	EVP_CIPHER_CTX* ctx;
+};
+
 }
 
 #endif
@@ -19,6 +19,7 @@ BPPlus::BPPlus(
         , Gi (Gi_)
         , Hi (Hi_)
         , N (N_)
+        , transcript_prefix (LABEL_TRANSCRIPT_BPPLUS)
 {
     if (Gi.size() != Hi.size()) {
         throw std::invalid_argument("Bad BPPlus generator sizes!");
@@ -35,6 +36,49 @@ BPPlus::BPPlus(
         TWO_N_MINUS_ONE *= TWO_N_MINUS_ONE;
     }
     TWO_N_MINUS_ONE -= ONE;
+
+    // The transcript prefix depends only on fixed parameters
+    transcript_prefix.add("G", G);
+    transcript_prefix.add("H", H);
+    transcript_prefix.add("Gi", Gi);
+    transcript_prefix.add("Hi", Hi);
+    transcript_prefix.add("N", Scalar(N));
+}
+
+BPPlus::BPPlus(
+        const FixedBaseExponent& G_table_,
+        const FixedBaseExponent& H_table_,
+        const std::vector<GroupElement>& Gi_,
+        const std::vector<GroupElement>& Hi_,
+        const FixedMultiExponent& Gi_table_,
+        const FixedMultiExponent& Hi_table_,
+        const std::size_t N_)
+        : BPPlus(G_table_.get_base(), H_table_.get_base(), Gi_, Hi_, N_)
+{
+    if (Gi_table_.size() != Gi.size() || Hi_table_.size() != Hi.size()) {
+        throw std::invalid_argument("Bad BPPlus generator table sizes!");
+    }
+    G_table = &G_table_;
+    H_table = &H_table_;
+    Gi_table = &Gi_table_;
+    Hi_table = &Hi_table_;
+}
+
+GroupElement BPPlus::mul_G(const Scalar& s) const {
+    return G_table ? G_table->get_multiple(s) : G*s;
+}
+
+GroupElement BPPlus::mul_H(const Scalar& s) const {
+    return H_table ? H_table->get_multiple(s) : H*s;
+}
+
+// Compute sum(Gi[i]*Gi_scalars[i] + Hi[i]*Hi_scalars[i]) over the leading generators
+GroupElement BPPlus::generator_multiple(const std::vector<Scalar>& Gi_scalars, const std::vector<Scalar>& Hi_scalars) const {
+    if (Gi_table && Hi_table) {
+        return Gi_table->get_multiple(Gi_scalars) + Hi_table->get_multiple(Hi_scalars);
+    }
+    return secp_primitives::MultiExponent(Gi.data(), Gi_scalars.data(), Gi_scalars.size()).get_multiple()
+        + secp_primitives::MultiExponent(Hi.data(), Hi_scalars.data(), Hi_scalars.size()).get_multiple();
 }
 
 // The floor function of log2
@@ -56,7 +100,7 @@ void BPPlus::prove(
         const std::vector<Scalar>& unpadded_v,
         const std::vector<Scalar>& unpadded_r,
         const std::vector<GroupElement>& unpadded_C,  
-        BPPlusProof& proof) {
+        BPPlusProof& proof) const {
     // Bulletproofs+ are only defined when the input set size is a nonzero power of two
     // To get around this, we can trivially pad the input set with zero commitments
     // We make sure this is done canonically in a way that's transparent to the caller
@@ -73,12 +117,7 @@ void BPPlus::prove(
 
     // Set up transcript, using the unpadded values
     // This is fine since the verifier canonically generates the same transcript
-    Transcript transcript(LABEL_TRANSCRIPT_BPPLUS);
-    transcript.add("G", G);
-    transcript.add("H", H);
-    transcript.add("Gi", Gi);
-    transcript.add("Hi", Hi);
-    transcript.add("N", Scalar(N));
+    Transcript transcript(transcript_prefix);
     transcript.add("C", unpadded_C);
 
     // Now pad the input set to produce a valid statement
@@ -105,7 +144,7 @@ void BPPlus::prove(
         throw std::invalid_argument("Bad BPPlus statement!5");
     }
     for (std::size_t j = 0; j < M; j++) {
-        if (!(G*v[j] + H*r[j] == C[j])) {
+        if (!(mul_G(v[j]) + mul_H(r[j]) == C[j])) {
             throw std::invalid_argument("Bad BPPlus statement!6");
         }
     }
@@ -134,21 +173,25 @@ void BPPlus::prove(
     Scalar alpha;
     alpha.randomize();
 
-    std::vector<GroupElement> A_points;
-    std::vector<Scalar> A_scalars;
-    A_points.reserve(2*N*M + 1);
-    A_scalars.reserve(2*N*M + 1);
+    if (Gi_table && Hi_table) {
+        proof.A = mul_H(alpha) + Gi_table->get_multiple(aL) + Hi_table->get_multiple(aR);
+    } else {
+        std::vector<GroupElement> A_points;
+        std::vector<Scalar> A_scalars;
+        A_points.reserve(2*N*M + 1);
+        A_scalars.reserve(2*N*M + 1);
 
-    A_points.emplace_back(H);
-    A_scalars.emplace_back(alpha);
-    for (std::size_t i = 0; i < N*M; i++) {
-        A_points.emplace_back(Gi[i]);
-        A_scalars.emplace_back(aL[i]);
-        A_points.emplace_back(Hi[i]);
-        A_scalars.emplace_back(aR[i]);
+        A_points.emplace_back(H);
+        A_scalars.emplace_back(alpha);
+        for (std::size_t i = 0; i < N*M; i++) {
+            A_points.emplace_back(Gi[i]);
+            A_scalars.emplace_back(aL[i]);
+            A_points.emplace_back(Hi[i]);
+            A_scalars.emplace_back(aR[i]);
+        }
+        secp_primitives::MultiExponent A_multiexp(A_points, A_scalars);
+        proof.A = A_multiexp.get_multiple();
     }
-    secp_primitives::MultiExponent A_multiexp(A_points, A_scalars);
-    proof.A = A_multiexp.get_multiple();
     transcript.add("A", proof.A);
 
     // Challenges
@@ -194,11 +237,27 @@ void BPPlus::prove(
     }
 
     // Run the inner product rounds
-    std::vector<GroupElement> Gi1(Gi);
-    std::vector<GroupElement> Hi1(Hi);
+    // Folding the generators as points costs two scalar multiplications per element, which dominates the early
+    // rounds; there the folded generators are instead tracked as scalars over the original generators, so L and R
+    // come from the fixed generators. In a round of size 2*N1, original index t contributes to folded index t mod N1.
+    // Once the rounds are small enough, the folded generators are computed explicitly and folded as points.
     std::vector<Scalar> a1(aL1);
     std::vector<Scalar> b1(aR1);
     std::size_t N1 = N*M;
+    std::vector<Scalar> Gi1_scalars(N1, ONE);
+    std::vector<Scalar> Hi1_scalars(N1, ONE);
+    std::vector<Scalar> Gi_scalars(N1);
+    std::vector<Scalar> Hi_scalars(N1);
+    std::vector<GroupElement> Gi1, Hi1;
+    bool folded_points = false;
+
+    // The rounds need the inverse of y**N1 for each halving of N1, which share one inversion
+    std::vector<Scalar> y_N1_inverses;
+    for (std::size_t i = N1 / 2; i > 0; i /= 2) {
+        y_N1_inverses.emplace_back(y_powers[i]);
+    }
+    Scalar::batch_invert(y_N1_inverses);
+    std::size_t round = 0;
 
     while (N1 > 1) {
         N1 /= 2;
@@ -216,37 +275,63 @@ void BPPlus::prove(
 
         // Compute L, R
         GroupElement L_, R_;
-        std::vector<GroupElement> L_points, R_points;
-        std::vector<Scalar> L_scalars, R_scalars;
-        L_points.reserve(2*N1 + 2);
-        R_points.reserve(2*N1 + 2);
-        L_scalars.reserve(2*N1 + 2);
-        R_scalars.reserve(2*N1 + 2);
-        Scalar y_N1_inverse = y_powers[N1].inverse();
-        for (std::size_t i = 0; i < N1; i++) {
-            L_points.emplace_back(Gi1[i+N1]);
-            L_scalars.emplace_back(a1[i]*y_N1_inverse);
-            L_points.emplace_back(Hi1[i]);
-            L_scalars.emplace_back(b1[i+N1]);
-
-            R_points.emplace_back(Gi1[i]);
-            R_scalars.emplace_back(a1[i+N1]*y_powers[N1]);
-            R_points.emplace_back(Hi1[i+N1]);
-            R_scalars.emplace_back(b1[i]);
+        const Scalar& y_N1_inverse = y_N1_inverses[round++];
+        if (!folded_points) {
+            // L uses the high half of Gi1 and the low half of Hi1, and R the opposite halves
+            for (std::size_t t = 0; t < N*M; t++) {
+                const std::size_t i = t % (2*N1);
+                if (i >= N1) {
+                    Gi_scalars[t] = a1[i-N1]*y_N1_inverse*Gi1_scalars[t];
+                    Hi_scalars[t] = ZERO;
+                } else {
+                    Gi_scalars[t] = ZERO;
+                    Hi_scalars[t] = b1[i+N1]*Hi1_scalars[t];
+                }
+            }
+            L_ = generator_multiple(Gi_scalars, Hi_scalars) + mul_G(cL) + mul_H(dL);
+            for (std::size_t t = 0; t < N*M; t++) {
+                const std::size_t i = t % (2*N1);
+                if (i < N1) {
+                    Gi_scalars[t] = a1[i+N1]*y_powers[N1]*Gi1_scalars[t];
+                    Hi_scalars[t] = ZERO;
+                } else {
+                    Gi_scalars[t] = ZERO;
+                    Hi_scalars[t] = b1[i-N1]*Hi1_scalars[t];
+                }
+            }
+            R_ = generator_multiple(Gi_scalars, Hi_scalars) + mul_G(cR) + mul_H(dR);
+        } else {
+            std::vector<GroupElement> L_points, R_points;
+            std::vector<Scalar> L_scalars, R_scalars;
+            L_points.reserve(2*N1 + 2);
+            R_points.reserve(2*N1 + 2);
+            L_scalars.reserve(2*N1 + 2);
+            R_scalars.reserve(2*N1 + 2);
+            for (std::size_t i = 0; i < N1; i++) {
+                L_points.emplace_back(Gi1[i+N1]);
+                L_scalars.emplace_back(a1[i]*y_N1_inverse);
+                L_points.emplace_back(Hi1[i]);
+                L_scalars.emplace_back(b1[i+N1]);
+
+                R_points.emplace_back(Gi1[i]);
+                R_scalars.emplace_back(a1[i+N1]*y_powers[N1]);
+                R_points.emplace_back(Hi1[i+N1]);
+                R_scalars.emplace_back(b1[i]);
+            }
+            L_points.emplace_back(G);
+            L_scalars.emplace_back(cL);
+            L_points.emplace_back(H);
+            L_scalars.emplace_back(dL);
+            R_points.emplace_back(G);
+            R_scalars.emplace_back(cR);
+            R_points.emplace_back(H);
+            R_scalars.emplace_back(dR);
+
+            secp_primitives::MultiExponent L_multiexp(L_points, L_scalars);
+            secp_primitives::MultiExponent R_multiexp(R_points, R_scalars);
+            L_ = L_multiexp.get_multiple();
+            R_ = R_multiexp.get_multiple();
         }
-        L_points.emplace_back(G);
-        L_scalars.emplace_back(cL);
-        L_points.emplace_back(H);
-        L_scalars.emplace_back(dL);
-        R_points.emplace_back(G);
-        R_scalars.emplace_back(cR);
-        R_points.emplace_back(H);
-        R_scalars.emplace_back(dR);
-
-        secp_primitives::MultiExponent L_multiexp(L_points, L_scalars);
-        secp_primitives::MultiExponent R_multiexp(R_points, R_scalars);
-        L_ = L_multiexp.get_multiple();
-        R_ = R_multiexp.get_multiple();
         proof.L.emplace_back(L_);
         proof.R.emplace_back(R_);
 
@@ -256,14 +341,56 @@ void BPPlus::prove(
         Scalar e_inverse = e.inverse();
 
         // Compress round elements
+        if (!folded_points) {
+            // Fold Gi1[i] = Gi1[i]*e_inverse + Gi1[i+N1]*(e*y_N1_inverse) and Hi1[i] = Hi1[i]*e + Hi1[i+N1]*e_inverse
+            Scalar e_y_N1_inverse = e*y_N1_inverse;
+            for (std::size_t t = 0; t < N*M; t++) {
+                if (t % (2*N1) < N1) {
+                    Gi1_scalars[t] *= e_inverse;
+                    Hi1_scalars[t] *= e;
+                } else {
+                    Gi1_scalars[t] *= e_y_N1_inverse;
+                    Hi1_scalars[t] *= e_inverse;
+                }
+            }
+
+            // Switch to folding points once each folded generator combines a few original generators
+            if (N1 > 1 && 8*N1 <= N*M) {
+                const std::size_t terms = N*M / N1;
+                std::vector<GroupElement> points(terms);
+                std::vector<Scalar> scalars(terms);
+                Gi1.reserve(N1);
+                Hi1.reserve(N1);
+                for (std::size_t i = 0; i < N1; i++) {
+                    for (std::size_t k = 0; k < terms; k++) {
+                        points[k] = Gi[i + k*N1];
+                        scalars[k] = Gi1_scalars[i + k*N1];
+                    }
+                    Gi1.emplace_back(secp_primitives::MultiExponent(points, scalars).get_multiple());
+                    for (std::size_t k = 0; k < terms; k++) {
+                        points[k] = Hi[i + k*N1];
+                        scalars[k] = Hi1_scalars[i + k*N1];
+                    }
+                    Hi1.emplace_back(secp_primitives::MultiExponent(points, scalars).get_multiple());
+                }
+                GroupElement::batch_normalize(Gi1);
+                GroupElement::batch_normalize(Hi1);
+                folded_points = true;
+            }
+        } else {
+            for (std::size_t i = 0; i < N1; i++) {
+                Gi1[i] = Gi1[i]*e_inverse + Gi1[i+N1]*(e*y_N1_inverse);
+                Hi1[i] = Hi1[i]*e + Hi1[i+N1]*e_inverse;
+            }
+            Gi1.resize(N1);
+            Hi1.resize(N1);
+            GroupElement::batch_normalize(Gi1);
+            GroupElement::batch_normalize(Hi1);
+        }
         for (std::size_t i = 0; i < N1; i++) {
-            Gi1[i] = Gi1[i]*e_inverse + Gi1[i+N1]*(e*y_N1_inverse);
-            Hi1[i] = Hi1[i]*e + Hi1[i+N1]*e_inverse;
             a1[i] = a1[i]*e + a1[i+N1]*y_powers[N1]*e_inverse;
             b1[i] = b1[i]*e_inverse + b1[i+N1]*e;
         }
-        Gi1.resize(N1);
-        Hi1.resize(N1);
         a1.resize(N1);
         b1.resize(N1);
 
@@ -278,8 +405,17 @@ void BPPlus::prove(
     d_.randomize();
     eta_.randomize();
 
-    proof.A1 = Gi1[0]*r_ + Hi1[0]*s_ + G*(r_*y*b1[0] + s_*y*a1[0]) + H*d_;
-    proof.B = G*(r_*y*s_) + H*eta_;
+    if (folded_points) {
+        proof.A1 = Gi1[0]*r_ + Hi1[0]*s_ + mul_G(r_*y*b1[0] + s_*y*a1[0]) + mul_H(d_);
+    } else {
+        // Gi1[0] and Hi1[0] are the full sums over the original generators
+        for (std::size_t t = 0; t < N*M; t++) {
+            Gi_scalars[t] = Gi1_scalars[t]*r_;
+            Hi_scalars[t] = Hi1_scalars[t]*s_;
+        }
+        proof.A1 = generator_multiple(Gi_scalars, Hi_scalars) + mul_G(r_*y*b1[0] + s_*y*a1[0]) + mul_H(d_);
+    }
+    proof.B = mul_G(r_*y*s_) + mul_H(eta_);
 
     transcript.add("A1", proof.A1);
     transcript.add("B", proof.B);
@@ -290,14 +426,150 @@ void BPPlus::prove(
     proof.d1 = eta_ + d_*e1 + alpha1*e1.square();
 }
 
-bool BPPlus::verify(const std::vector<GroupElement>& unpadded_C, const BPPlusProof& proof) {
+// Add the terms of a single proof to a batch, given its challenges and the inverses of y and the round challenges
+void BPPlus::process_proof(
+        const std::vector<GroupElement>& unpadded_C,
+        const BPPlusProof& proof,
+        const Scalar& y,
+        const Scalar& z,
+        const std::vector<Scalar>& e,
+        const Scalar& e1,
+        const Scalar* inverses,
+        BPPlusBatchTerms& batch) const {
+    const std::size_t unpadded_M = unpadded_C.size();
+    const std::size_t rounds = proof.L.size();
+
+    // Weight this proof in the batch
+    Scalar w = ZERO;
+    while (w == ZERO) {
+        w.randomize();
+    }
+
+    // Pad to a valid statement if needed
+    std::size_t M = unpadded_M;
+    if (!is_nonzero_power_of_2(M)) {
+        M = 1 << (log2(unpadded_M) + 1);
+    }
+
+    // Challenges and their inverses
+    const Scalar& y_inverse = inverses[0];
+    Scalar y_NM = y;
+    for (std::size_t i = 0; i < rounds; i++) {
+        y_NM = y_NM.square();
+    }
+    Scalar y_NM_1 = y_NM*y;
+
+    Scalar z_square = z.square();
+
+    const Scalar* e_inverse = inverses + 1;
+
+    Scalar e1_square = e1.square();
+
+    // C_j: -e1**2 * z**(2*(j + 1)) * y**(N*M + 1) * w
+    // Padding commitments are the identity, so only the unpadded ones are added
+    Scalar C_scalar = e1_square.negate()*z_square*y_NM_1*w;
+    for (std::size_t j = 0; j < unpadded_M; j++) {
+        batch.points.emplace_back(unpadded_C[j]);
+        batch.scalars.emplace_back(C_scalar);
+
+        C_scalar *= z_square;
+    }
+
+    // B: -w
+    batch.points.emplace_back(proof.B);
+    batch.scalars.emplace_back(w.negate());
+
+    // A1: -w*e1
+    batch.points.emplace_back(proof.A1);
+    batch.scalars.emplace_back(w.negate()*e1);
+
+    // A: -w*e1**2
+    batch.points.emplace_back(proof.A);
+    batch.scalars.emplace_back(w.negate()*e1_square);
+
+    // H: w*d1
+    batch.H_scalar += w*proof.d1;
+
+    // Sum the elements of d
+    Scalar sum_d = z_square;
+    Scalar temp_z = sum_d;
+    std::size_t temp_2M = 2*M;
+    while (temp_2M > 2) {
+        sum_d += sum_d*temp_z;
+        temp_z = temp_z.square();
+        temp_2M /= 2;
+    }
+    sum_d *= TWO_N_MINUS_ONE;
+
+    // Sum the powers of y
+    Scalar sum_y;
+    Scalar track = y;
+    for (std::size_t i = 0; i < N*M; i++) {
+        sum_y += track;
+        track *= y;
+    }
+
+    // G: w*(r1*y*s1 + e1**2*(y**(N*M + 1)*z*sum_d + (z**2-z)*sum_y))
+    batch.G_scalar += w*(proof.r1*y*proof.s1 + e1_square*(y_NM_1*z*sum_d + (z_square - z)*sum_y));
+
+    // Challenge products: bit j of i selects e[rounds-j-1] if set and its inverse otherwise
+    // Setting the highest bit of i swaps one inverse for the challenge, so each product takes one multiplication
+    std::vector<Scalar> challenge_products(N*M);
+    challenge_products[0] = ONE;
+    for (std::size_t j = 0; j < rounds; j++) {
+        challenge_products[0] *= e_inverse[j];
+    }
+    for (std::size_t k = 0; k < rounds; k++) {
+        const Scalar e_square = e[rounds-k-1].square();
+        const std::size_t bit = std::size_t(1) << k;
+        for (std::size_t i = bit; i < 2*bit; i++) {
+            challenge_products[i] = challenge_products[i - bit]*e_square;
+        }
+    }
+
+    // Gi, Hi
+    // The Hi products use the complementary bits, so they are the Gi products in reverse order
+    const Scalar w_r1_e1 = w*proof.r1*e1;
+    const Scalar w_s1_e1 = w*proof.s1*e1;
+    const Scalar w_e1_square = w*e1_square;
+    const Scalar w_e1_square_z = w_e1_square*z;
+    Scalar iter_y_inv = ONE; // y.inverse()**i
+    Scalar iter_y_NM = y_NM; // y**(N*M - i)
+    Scalar d = z_square; // z**(2*(j + 1)) * 2**i for i = j*N + i
+    for (std::size_t j = 0; j < M; j++) {
+        Scalar d_j = d;
+        for (std::size_t i = j*N; i < (j + 1)*N; i++) {
+            // Gi
+            batch.Gi_scalars[i] += w_r1_e1*iter_y_inv*challenge_products[i] + w_e1_square_z;
+
+            // Hi
+            batch.Hi_scalars[i] += w_s1_e1*challenge_products[N*M - 1 - i] - w_e1_square*d_j*iter_y_NM - w_e1_square_z;
+
+            // Update the iterated values
+            d_j += d_j;
+            iter_y_inv *= y_inverse;
+            iter_y_NM *= y_inverse;
+        }
+        d *= z_square;
+    }
+
+    // L, R
+    for (std::size_t j = 0; j < rounds; j++) {
+        batch.points.emplace_back(proof.L[j]);
+        batch.scalars.emplace_back(w_e1_square.negate()*e[j].square());
+        batch.points.emplace_back(proof.R[j]);
+        batch.scalars.emplace_back(w_e1_square.negate()*e_inverse[j].square());
+    }
+}
+
+bool BPPlus::verify(const std::vector<GroupElement>& unpadded_C, const BPPlusProof& proof) const {
     std::vector<std::vector<GroupElement>> unpadded_C_batch = {unpadded_C};
     std::vector<BPPlusProof> proof_batch = {proof};
 
     return verify(unpadded_C_batch, proof_batch);
 }
 
-bool BPPlus::verify(const std::vector<std::vector<GroupElement>>& unpadded_C, const std::vector<BPPlusProof>& proofs) {
+bool BPPlus::verify(const std::vector<std::vector<GroupElement>>& unpadded_C, const std::vector<BPPlusProof>& proofs, ThreadPool* thread_pool) const {
     // Preprocess all proofs
     if (!(unpadded_C.size() == proofs.size())) {
         return false;
@@ -338,71 +610,37 @@ bool BPPlus::verify(const std::vector<std::vector<GroupElement>>& unpadded_C, co
         return false;
     }
 
-    // Set up final multiscalar multiplication and common scalars
-    std::vector<GroupElement> points;
-    std::vector<Scalar> scalars;
-    Scalar G_scalar, H_scalar;
-
-    // Interleave the Gi and Hi scalars
-    for (std::size_t i = 0; i < max_M*N; i++) {
-        points.emplace_back(Gi[i]);
-        scalars.emplace_back(ZERO);
-        points.emplace_back(Hi[i]);
-        scalars.emplace_back(ZERO);
-    }
-
-    // Process each proof and add to the batch
+    // Derive the challenges of every proof first, so their inverses share a single inversion
+    std::vector<Scalar> y_challenges, z_challenges, e1_challenges;
+    std::vector<std::vector<Scalar>> e_challenges;
+    std::vector<Scalar> inverses; // y followed by the round challenges, for each proof
+    std::vector<std::size_t> inverse_offsets; // where each proof's inverses start
+    y_challenges.reserve(N_proofs);
+    z_challenges.reserve(N_proofs);
+    e1_challenges.reserve(N_proofs);
+    e_challenges.reserve(N_proofs);
+    inverse_offsets.reserve(N_proofs);
     for (std::size_t k_proofs = 0; k_proofs < N_proofs; k_proofs++) {
-        const BPPlusProof proof = proofs[k_proofs];
-        const std::size_t unpadded_M = unpadded_C[k_proofs].size();
+        const BPPlusProof& proof = proofs[k_proofs];
         const std::size_t rounds = proof.L.size();
 
-        // Weight this proof in the batch
-        Scalar w = ZERO;
-        while (w == ZERO) {
-            w.randomize();
-        }
-
         // Set up transcript
-        Transcript transcript(LABEL_TRANSCRIPT_BPPLUS);
-        transcript.add("G", G);
-        transcript.add("H", H);
-        transcript.add("Gi", Gi);
-        transcript.add("Hi", Hi);
-        transcript.add("N", Scalar(N));
+        Transcript transcript(transcript_prefix);
         transcript.add("C", unpadded_C[k_proofs]);
         transcript.add("A", proof.A);
 
-        // Pad to a valid statement if needed
-        std::size_t M = unpadded_M;
-        if (!is_nonzero_power_of_2(M)) {
-            M = 1 << (log2(unpadded_M) + 1);
-        }
-        std::vector<GroupElement> C(unpadded_C[k_proofs]);
-        for (std::size_t i = unpadded_M; i < M; i++) {
-            C.emplace_back();
-        }
-
         // Get challenges
         Scalar y = transcript.challenge("y");
         if (y == ZERO) {
             return false;
         }
-        Scalar y_inverse = y.inverse();
-        Scalar y_NM = y;
-        for (std::size_t i = 0; i < rounds; i++) {
-            y_NM = y_NM.square();
-        }
-        Scalar y_NM_1 = y_NM*y;
 
         Scalar z = transcript.challenge("z");
         if (z == ZERO) {
             return false;
         }
-        Scalar z_square = z.square();
 
         std::vector<Scalar> e;
-        std::vector<Scalar> e_inverse;
         for (std::size_t j = 0; j < rounds; j++) {
             transcript.add("L", proof.L[j]);
             transcript.add("R", proof.R[j]);
@@ -411,7 +649,6 @@ bool BPPlus::verify(const std::vector<std::vector<GroupElement>>& unpadded_C, co
                 return false;
             }
             e.emplace_back(e_);
-            e_inverse.emplace_back(e[j].inverse());
         }
 
         transcript.add("A1", proof.A1);
@@ -420,102 +657,67 @@ bool BPPlus::verify(const std::vector<std::vector<GroupElement>>& unpadded_C, co
         if (e1 == ZERO) {
             return false;
         }
-        Scalar e1_square = e1.square();
-
-        // C_j: -e1**2 * z**(2*(j + 1)) * y**(N*M + 1) * w
-        Scalar C_scalar = e1_square.negate()*z_square*y_NM_1*w;
-        for (std::size_t j = 0; j < M; j++) {
-            points.emplace_back(C[j]);
-            scalars.emplace_back(C_scalar);
-
-            C_scalar *= z.square();
-        }
-
-        // B: -w
-        points.emplace_back(proof.B);
-        scalars.emplace_back(w.negate());
-
-        // A1: -w*e1
-        points.emplace_back(proof.A1);
-        scalars.emplace_back(w.negate()*e1);
-
-        // A: -w*e1**2
-        points.emplace_back(proof.A);
-        scalars.emplace_back(w.negate()*e1_square);
-
-        // H: w*d1
-        H_scalar += w*proof.d1;
-
-        // Compute d
-        std::vector<Scalar> d;
-        d.resize(N*M);
-        d[0] = z_square;
-        for (std::size_t i = 1; i < N; i++) {
-            d[i] = d[i-1] + d[i-1];
-        }
-        for (std::size_t j = 1; j < M; j++) {
-            for (std::size_t i = 0; i < N; i++) {
-                d[j*N + i] = d[(j - 1)*N + i]*z_square;
-            }
-        }
-
-        // Sum the elements of d
-        Scalar sum_d = z_square;
-        Scalar temp_z = sum_d;
-        std::size_t temp_2M = 2*M;
-        while (temp_2M > 2) {
-            sum_d += sum_d*temp_z;
-            temp_z = temp_z.square();
-            temp_2M /= 2;
-        }
-        sum_d *= TWO_N_MINUS_ONE;
 
-        // Sum the powers of y
-        Scalar sum_y;
-        Scalar track = y;
-        for (std::size_t i = 0; i < N*M; i++) {
-            sum_y += track;
-            track *= y;
+        inverse_offsets.emplace_back(inverses.size());
+        inverses.emplace_back(y);
+        inverses.insert(inverses.end(), e.begin(), e.end());
+        y_challenges.emplace_back(y);
+        z_challenges.emplace_back(z);
+        e_challenges.emplace_back(std::move(e));
+        e1_challenges.emplace_back(e1);
+    }
+    Scalar::batch_invert(inverses);
+
+    // Process each proof into a set of batch terms; with a pool, proofs are processed in parallel
+    // with one set of terms per chunk of proofs, and the sets are merged afterwards
+    const std::size_t chunks = thread_pool ? std::max(std::min(N_proofs, thread_pool->size() + 1), std::size_t(1)) : 1;
+    const std::size_t chunk_size = (N_proofs + chunks - 1) / chunks;
+    std::vector<BPPlusBatchTerms> terms(chunks);
+    auto process_chunk = [&](std::size_t c) {
+        BPPlusBatchTerms& batch = terms[c];
+        batch.Gi_scalars.resize(max_M*N);
+        batch.Hi_scalars.resize(max_M*N);
+        for (std::size_t k_proofs = c*chunk_size; k_proofs < std::min((c + 1)*chunk_size, N_proofs); k_proofs++) {
+            process_proof(
+                unpadded_C[k_proofs],
+                proofs[k_proofs],
+                y_challenges[k_proofs],
+                z_challenges[k_proofs],
+                e_challenges[k_proofs],
+                e1_challenges[k_proofs],
+                &inverses[inverse_offsets[k_proofs]],
+                batch);
         }
+    };
+    if (thread_pool) {
+        thread_pool->parallel_for(chunks, process_chunk);
+    } else {
+        process_chunk(0);
+    }
 
-        // G: w*(r1*y*s1 + e1**2*(y**(N*M + 1)*z*sum_d + (z**2-z)*sum_y))
-        G_scalar += w*(proof.r1*y*proof.s1 + e1_square*(y_NM_1*z*sum_d + (z_square - z)*sum_y));
-
-        // Track some iterated exponential terms
-        Scalar iter_y_inv = ONE; // y.inverse()**i
-        Scalar iter_y_NM = y_NM; // y**(N*M - i)
-
-        // Gi, Hi
-        for (std::size_t i = 0; i < N*M; i++) {
-            Scalar g = proof.r1*e1*iter_y_inv;
-            Scalar h = proof.s1*e1;
-            for (std::size_t j = 0; j < rounds; j++) {
-                if ((i >> j) & 1) {
-                    g *= e[rounds-j-1];
-                    h *= e_inverse[rounds-j-1];
-                } else {
-                    h *= e[rounds-j-1];
-                    g *= e_inverse[rounds-j-1];
-                }
+    // Merge the terms
+    std::vector<GroupElement> points;
+    std::vector<Scalar> scalars;
+    Scalar G_scalar, H_scalar;
+    std::vector<Scalar>& Gi_scalars = terms[0].Gi_scalars;
+    std::vector<Scalar>& Hi_scalars = terms[0].Hi_scalars;
+    std::size_t final_size = 2*max_M*N + 3;
+    for (const BPPlusBatchTerms& batch : terms) {
+        final_size += batch.points.size();
+    }
+    points.reserve(final_size);
+    scalars.reserve(final_size);
+    for (std::size_t c = 0; c < chunks; c++) {
+        const BPPlusBatchTerms& batch = terms[c];
+        points.insert(points.end(), batch.points.begin(), batch.points.end());
+        scalars.insert(scalars.end(), batch.scalars.begin(), batch.scalars.end());
+        G_scalar += batch.G_scalar;
+        H_scalar += batch.H_scalar;
+        if (c > 0) {
+            for (std::size_t i = 0; i < max_M*N; i++) {
+                Gi_scalars[i] += batch.Gi_scalars[i];
+                Hi_scalars[i] += batch.Hi_scalars[i];
             }
-
-            // Gi
-            scalars[2*i] += w*(g + e1_square*z);
-            
-            // Hi
-            scalars[2*i+1] += w*(h - e1_square*(d[i]*iter_y_NM+z));
-
-            // Update the iterated values
-            iter_y_inv *= y_inverse;
-            iter_y_NM *= y_inverse;
-        }
-
-        // L, R
-        for (std::size_t j = 0; j < rounds; j++) {
-            points.emplace_back(proof.L[j]);
-            scalars.emplace_back(w*(e1_square.negate()*e[j].square()));
-            points.emplace_back(proof.R[j]);
-            scalars.emplace_back(w*(e1_square.negate()*e_inverse[j].square()));
         }
     }
 
@@ -524,6 +726,17 @@ bool BPPlus::verify(const std::vector<std::vector<GroupElement>>& unpadded_C, co
     scalars.emplace_back(G_scalar);
     points.emplace_back(H);
     scalars.emplace_back(H_scalar);
+    if (Gi_table && Hi_table) {
+        points.emplace_back(Gi_table->get_multiple(Gi_scalars) + Hi_table->get_multiple(Hi_scalars));
+        scalars.emplace_back(ONE);
+    } else {
+        for (std::size_t i = 0; i < max_M*N; i++) {
+            points.emplace_back(Gi[i]);
+            scalars.emplace_back(Gi_scalars[i]);
+            points.emplace_back(Hi[i]);
+            scalars.emplace_back(Hi_scalars[i]);
+        }
+    }
 
     // Test the batch
     secp_primitives::MultiExponent multiexp(points, scalars);
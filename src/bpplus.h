@@ -3,32 +3,75 @@
 
 #include "bpplus_proof.h"
 #include "../secp256k1/include/MultiExponent.h"
+#include "../secp256k1/include/FixedBaseExponent.h"
+#include "../secp256k1/include/FixedMultiExponent.h"
+#include "thread_pool.h"
+#include "transcript.h"
 
 namespace spark {
     
 std::size_t log2(std::size_t n);
 bool is_nonzero_power_of_2(std::size_t n);
 
+// Terms of a batch verification's final multiscalar multiplication, contributed by a group of proofs
+struct BPPlusBatchTerms {
+    std::vector<GroupElement> points;
+    std::vector<Scalar> scalars;
+    Scalar G_scalar;
+    Scalar H_scalar;
+    std::vector<Scalar> Gi_scalars;
+    std::vector<Scalar> Hi_scalars;
+};
+
 class BPPlus {
 public:
+    // Generators and tables are referenced rather than copied, so they must outlive the instance
+    // Copying an instance is cheap, and the copy shares the same generators
     BPPlus(
         const GroupElement& G,
         const GroupElement& H,
         const std::vector<GroupElement>& Gi,
         const std::vector<GroupElement>& Hi,
         const std::size_t N);
+    BPPlus(
+        const FixedBaseExponent& G_table,
+        const FixedBaseExponent& H_table,
+        const std::vector<GroupElement>& Gi,
+        const std::vector<GroupElement>& Hi,
+        const FixedMultiExponent& Gi_table,
+        const FixedMultiExponent& Hi_table,
+        const std::size_t N);
     
-    void prove(const std::vector<Scalar>& unpadded_v, const std::vector<Scalar>& unpadded_r, const std::vector<GroupElement>& unpadded_C, BPPlusProof& proof);
-    bool verify(const std::vector<GroupElement>& unpadded_C, const BPPlusProof& proof); // single proof
-    bool verify(const std::vector<std::vector<GroupElement>>& unpadded_C, const std::vector<BPPlusProof>& proofs); // batch of proofs
+    void prove(const std::vector<Scalar>& unpadded_v, const std::vector<Scalar>& unpadded_r, const std::vector<GroupElement>& unpadded_C, BPPlusProof& proof) const;
+    bool verify(const std::vector<GroupElement>& unpadded_C, const BPPlusProof& proof) const; // single proof
+    // With a pool, batch verification processes proofs in parallel before the final multiscalar multiplication
+    bool verify(const std::vector<std::vector<GroupElement>>& unpadded_C, const std::vector<BPPlusProof>& proofs, ThreadPool* thread_pool = nullptr) const; // batch of proofs
 
 private:
-    GroupElement G;
-    GroupElement H;
-    std::vector<GroupElement> Gi;
-    std::vector<GroupElement> Hi;
+    GroupElement mul_G(const Scalar& s) const;
+    GroupElement mul_H(const Scalar& s) const;
+    GroupElement generator_multiple(const std::vector<Scalar>& Gi_scalars, const std::vector<Scalar>& Hi_scalars) const;
+    void process_proof(
+        const std::vector<GroupElement>& unpadded_C,
+        const BPPlusProof& proof,
+        const Scalar& y,
+        const Scalar& z,
+        const std::vector<Scalar>& e,
+        const Scalar& e1,
+        const Scalar* inverses,
+        BPPlusBatchTerms& batch) const;
+
+    const GroupElement& G;
+    const GroupElement& H;
+    const FixedBaseExponent* G_table = nullptr;
+    const FixedBaseExponent* H_table = nullptr;
+    const FixedMultiExponent* Gi_table = nullptr;
+    const FixedMultiExponent* Hi_table = nullptr;
+    const std::vector<GroupElement>& Gi;
+    const std::vector<GroupElement>& Hi;
     std::size_t N;
     Scalar TWO_N_MINUS_ONE;
+    Transcript transcript_prefix; // domain, generators and bit length, shared by every proof
 };
 
 }
@@ -4,7 +4,16 @@
 namespace spark {
 
 Chaum::Chaum(const GroupElement& F_, const GroupElement& G_, const GroupElement& H_, const GroupElement& U_):
-    F(F_), G(G_), H(H_), U(U_) {
+    F(F_), G(G_), H(H_), U(U_), F_table(nullptr), G_table(nullptr), H_table(nullptr) {
+}
+
+Chaum::Chaum(const FixedBaseExponent& F_table_, const FixedBaseExponent& G_table_, const FixedBaseExponent& H_table_, const GroupElement& U_):
+    F(F_table_.get_base()), G(G_table_.get_base()), H(H_table_.get_base()), U(U_),
+    F_table(&F_table_), G_table(&G_table_), H_table(&H_table_) {
+}
+
+GroupElement Chaum::mul(const GroupElement& base, const FixedBaseExponent* table, const Scalar& s) const {
+    return table ? table->get_multiple(s) : base*s;
 }
 
 Scalar Chaum::challenge(
@@ -43,7 +52,8 @@ void Chaum::prove(
         throw std::invalid_argument("Bad Chaum statement!");
     }
     for (std::size_t i = 0; i < n; i++) {
-        if (!(F*x[i] + G*y[i] + H*z[i] == S[i] && T[i]*x[i] + G*y[i] == U)) {
+        GroupElement Gy = mul(G, G_table, y[i]);
+        if (!(mul(F, F_table, x[i]) + Gy + mul(H, H_table, z[i]) == S[i] && T[i]*x[i] + Gy == U)) {
             throw std::invalid_argument("Bad Chaum statement!");
         }
     }
@@ -59,11 +69,12 @@ void Chaum::prove(
     Scalar t;
     t.randomize();
 
-    proof.A1 = H*t;
+    proof.A1 = mul(H, H_table, t);
     proof.A2.resize(n);
     for (std::size_t i = 0; i < n; i++) {
-        proof.A1 += F*r[i] + G*s[i];
-        proof.A2[i] = T[i]*r[i] + G*s[i];
+        GroupElement Gs = mul(G, G_table, s[i]);
+        proof.A1 += mul(F, F_table, r[i]) + Gs;
+        proof.A2[i] = T[i]*r[i] + Gs;
     }
 
     Scalar c = challenge(mu, S, T, proof.A1, proof.A2);
@@ -3,12 +3,14 @@
 
 #include "chaum_proof.h"
 #include "../secp256k1/include/MultiExponent.h"
+#include "../secp256k1/include/FixedBaseExponent.h"
 
 namespace spark {
 
 class Chaum {
 public:
     Chaum(const GroupElement& F, const GroupElement& G, const GroupElement& H, const GroupElement& U);
+    Chaum(const FixedBaseExponent& F_table, const FixedBaseExponent& G_table, const FixedBaseExponent& H_table, const GroupElement& U); // U is never multiplied, so it needs no table
 
     void prove(
         const Scalar& mu,
@@ -34,10 +36,14 @@ private:
         const GroupElement& A1,
         const std::vector<GroupElement>& A2
     );
+    GroupElement mul(const GroupElement& base, const FixedBaseExponent* table, const Scalar& s) const;
     const GroupElement& F;
     const GroupElement& G;
     const GroupElement& H;
     const GroupElement& U;
+    const FixedBaseExponent* F_table;
+    const FixedBaseExponent* G_table;
+    const FixedBaseExponent* H_table;
 };
 
 }
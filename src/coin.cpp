@@ -1,5 +1,6 @@
 #include "coin.h"
 #include "../bitcoin/hash.h"
+#include "../secp256k1/include/MultiExponent.h"
 
 namespace spark {
 
@@ -39,10 +40,10 @@ Coin::Coin(
 	this->K = SparkUtils::hash_div(address.get_d())*SparkUtils::hash_k(k);
 
 	// Construct the serial commitment
-	this->S = this->params->get_F()*SparkUtils::hash_ser(k, serial_context) + address.get_Q2();
+	this->S = this->params->mul_F(SparkUtils::hash_ser(k, serial_context)) + address.get_Q2();
 
 	// Construct the value commitment
-	this->C = this->params->get_G()*Scalar(v) + this->params->get_H()*SparkUtils::hash_val(k);
+	this->C = this->params->mul_G(Scalar(v)) + this->params->mul_H(SparkUtils::hash_val(k));
 
 	// Check the memo validity, and pad if needed
 	if (memo.size() > this->params->get_memo_bytes()) {
@@ -87,27 +88,71 @@ Coin::Coin(
 bool Coin::validate(
 	const IncomingViewKey& incoming_view_key,
 	IdentifiedCoinData& data
-) {
+) const {
+	// The encrypted diversifier must be a single block
+	if (data.d.size() != AES_BLOCKSIZE) {
+		return false;
+	}
+
 	// Check recovery key
 	if (SparkUtils::hash_div(data.d)*SparkUtils::hash_k(data.k) != this->K) {
         return false;
 	}
 
 	// Check value commitment
-	if (this->params->get_G()*Scalar(data.v) + this->params->get_H()*SparkUtils::hash_val(data.k) != this->C) {
+	if (this->params->mul_G(Scalar(data.v)) + this->params->mul_H(SparkUtils::hash_val(data.k)) != this->C) {
         return false;
 	}
 
 	// Check serial commitment
 	data.i = incoming_view_key.get_diversifier(data.d);
 
-	if (this->params->get_F()*(SparkUtils::hash_ser(data.k, this->serial_context) + SparkUtils::hash_Q2(incoming_view_key.get_s1(), data.i)) + incoming_view_key.get_P2() != this->S) {
+	if (this->params->mul_F(SparkUtils::hash_ser(data.k, this->serial_context) + SparkUtils::hash_Q2(incoming_view_key.get_s1(), data.i)) + incoming_view_key.get_P2() != this->S) {
         return false;
 	}
 
 	return true;
 }
 
+// Validate a coin for identification using a prepared key
+// For a cached diversifier this leaves one variable-base multiplication; the other terms use fixed-base tables
+bool Coin::validate(
+	const PreparedIncomingViewKey& incoming_view_key,
+	IdentifiedCoinData& data
+) const {
+	if (!incoming_view_key.get_diversifier(data.d, data.i)) {
+		return false;
+	}
+
+	// Use cached diversifier values when available
+	GroupElement div, Q2;
+	const PreparedDiversifier* prepared = incoming_view_key.get_prepared(data.i);
+	if (prepared && prepared->d == data.d) {
+		div = prepared->div;
+		Q2 = prepared->Q2;
+	} else {
+		div = SparkUtils::hash_div(data.d);
+		Q2 = this->params->mul_F(SparkUtils::hash_Q2(incoming_view_key.get_s1(), data.i)) + incoming_view_key.get_incoming_view_key().get_P2();
+	}
+
+	// Check recovery key
+	if (div*SparkUtils::hash_k(data.k) != this->K) {
+		return false;
+	}
+
+	// Check value commitment
+	if (this->params->mul_G(Scalar(data.v)) + this->params->mul_H(SparkUtils::hash_val(data.k)) != this->C) {
+		return false;
+	}
+
+	// Check serial commitment
+	if (this->params->mul_F(SparkUtils::hash_ser(data.k, this->serial_context)) + Q2 != this->S) {
+		return false;
+	}
+
+	return true;
+}
+
 // Recover a coin
 RecoveredCoinData Coin::recover(const FullViewKey& full_view_key, const IdentifiedCoinData& data) {
 	RecoveredCoinData recovered_data;
@@ -117,26 +162,246 @@ RecoveredCoinData Coin::recover(const FullViewKey& full_view_key, const Identifi
 	return recovered_data;
 }
 
+// Recover a batch of coins
+std::vector<RecoveredCoinData> Coin::recover(const FullViewKey& full_view_key, const std::vector<Coin>& coins, const std::vector<IdentifiedCoinData>& data) {
+	if (coins.size() != data.size()) {
+		throw std::invalid_argument("Bad coin recovery batch");
+	}
+
+	std::vector<RecoveredCoinData> recovered_data(coins.size());
+	std::vector<Scalar> s_inverse;
+	s_inverse.reserve(coins.size());
+	for (std::size_t i = 0; i < coins.size(); i++) {
+		recovered_data[i].s = SparkUtils::hash_ser(data[i].k, coins[i].serial_context) + SparkUtils::hash_Q2(full_view_key.get_s1(), data[i].i) + full_view_key.get_s2();
+		s_inverse.emplace_back(recovered_data[i].s);
+	}
+	Scalar::batch_invert(s_inverse);
+
+	const GroupElement D_inverse = full_view_key.get_D().inverse();
+	for (std::size_t i = 0; i < coins.size(); i++) {
+		recovered_data[i].T = (coins[i].params->get_U() + D_inverse)*s_inverse[i];
+	}
+
+	return recovered_data;
+}
+
 // Identify a coin
-IdentifiedCoinData Coin::identify(const IncomingViewKey& incoming_view_key) {
+IdentifiedCoinData Coin::identify(const IncomingViewKey& incoming_view_key) const {
+	AEADDecryptor decryptor;
+	return identify(incoming_view_key, decryptor);
+}
+
+IdentifiedCoinData Coin::identify(const IncomingViewKey& incoming_view_key, AEADDecryptor& decryptor) const {
 	IdentifiedCoinData data;
+	if (!decrypt_recipient_data(this->K*incoming_view_key.get_s1(), false, decryptor, data)) {
+		throw std::runtime_error("Unable to identify coin");
+	}
+
+	// Validate the coin
+	if (!validate(incoming_view_key, data)) {
+		throw std::runtime_error("Malformed coin");
+	}
+
+	return data;
+}
+
+std::optional<IdentifiedCoinData> Coin::try_identify(const IncomingViewKey& incoming_view_key) const {
+	AEADDecryptor decryptor;
+	return try_identify(incoming_view_key, decryptor);
+}
+
+std::optional<IdentifiedCoinData> Coin::try_identify(const IncomingViewKey& incoming_view_key, AEADDecryptor& decryptor) const {
+	IdentifiedCoinData data;
+	if (!decrypt_recipient_data(this->K*incoming_view_key.get_s1(), false, decryptor, data) || !validate(incoming_view_key, data)) {
+		return std::nullopt;
+	}
+
+	return data;
+}
+
+std::optional<IdentifiedCoinData> Coin::try_identify(const PreparedIncomingViewKey& incoming_view_key, AEADDecryptor& decryptor) const {
+	IdentifiedCoinData data;
+	if (!decrypt_recipient_data(this->K*incoming_view_key.get_s1(), false, decryptor, data) || !validate(incoming_view_key, data)) {
+		return std::nullopt;
+	}
+
+	return data;
+}
+
+std::optional<IdentifiedCoinData> Coin::try_identify(const PreparedIncomingViewKey& incoming_view_key, const GroupElement& prekey, AEADDecryptor& decryptor) const {
+	IdentifiedCoinData data;
+	if (!decrypt_recipient_data(prekey, true, decryptor, data) || !validate(incoming_view_key, data)) {
+		return std::nullopt;
+	}
+
+	return data;
+}
+
+std::vector<std::optional<IdentifiedCoinData>> Coin::try_identify(const PreparedIncomingViewKey& incoming_view_key, const std::vector<Coin>& coins, AEADDecryptor& decryptor) {
+	return try_identify(incoming_view_key, coins.data(), coins.size(), decryptor);
+}
+
+// Terms of one decrypted coin's validation equations
+struct CoinValidationTerms {
+	std::size_t index;
+	GroupElement div; // hash_div(d)
+	GroupElement Q2; // address component of the serial commitment
+	Scalar hash_k;
+	Scalar hash_val;
+	Scalar hash_ser;
+};
+
+// Check the validation equations of coins [begin, end) as one random linear combination:
+//   div*hash_k - K, G*v + H*hash_val - C, and F*hash_ser + Q2 - S must all be zero
+// On failure, halves are checked separately until the malformed coins are isolated
+static void validate_batch(
+	const Coin* coins,
+	const std::vector<IdentifiedCoinData>& data,
+	const std::vector<CoinValidationTerms>& terms,
+	const std::size_t begin,
+	const std::size_t end,
+	std::vector<bool>& valid
+) {
+	const Params* params = coins[terms[begin].index].params;
+	const std::size_t n = end - begin;
+
+	std::vector<GroupElement> points;
+	std::vector<Scalar> scalars;
+	points.reserve(5*n + 3);
+	scalars.reserve(5*n + 3);
+	Scalar F_scalar, G_scalar, H_scalar;
+	for (std::size_t t = begin; t < end; t++) {
+		const Coin& coin = coins[terms[t].index];
+		Scalar w1, w2, w3;
+		w1.randomize();
+		w2.randomize();
+		w3.randomize();
+
+		// Recovery key
+		points.emplace_back(terms[t].div);
+		scalars.emplace_back(w1*terms[t].hash_k);
+		points.emplace_back(coin.K);
+		scalars.emplace_back(w1.negate());
+
+		// Value commitment
+		G_scalar += w2*Scalar(data[t].v);
+		H_scalar += w2*terms[t].hash_val;
+		points.emplace_back(coin.C);
+		scalars.emplace_back(w2.negate());
+
+		// Serial commitment
+		F_scalar += w3*terms[t].hash_ser;
+		points.emplace_back(terms[t].Q2);
+		scalars.emplace_back(w3);
+		points.emplace_back(coin.S);
+		scalars.emplace_back(w3.negate());
+	}
+	points.emplace_back(params->get_F());
+	scalars.emplace_back(F_scalar);
+	points.emplace_back(params->get_G());
+	scalars.emplace_back(G_scalar);
+	points.emplace_back(params->get_H());
+	scalars.emplace_back(H_scalar);
+
+	secp_primitives::MultiExponent multiexp(points, scalars);
+	if (multiexp.get_multiple().isInfinity()) {
+		for (std::size_t t = begin; t < end; t++) {
+			valid[t] = true;
+		}
+		return;
+	}
+	if (n == 1) {
+		return;
+	}
+
+	const std::size_t middle = begin + n/2;
+	validate_batch(coins, data, terms, begin, middle, valid);
+	validate_batch(coins, data, terms, middle, end, valid);
+}
+
+std::vector<std::optional<IdentifiedCoinData>> Coin::try_identify(const PreparedIncomingViewKey& incoming_view_key, const Coin* coins, const std::size_t n_coins, AEADDecryptor& decryptor) {
+	std::vector<std::optional<IdentifiedCoinData>> result(n_coins);
+
+	// Decrypt every coin, keeping those sent to this key
+	std::vector<IdentifiedCoinData> data;
+	std::vector<CoinValidationTerms> terms;
+	for (std::size_t j = 0; j < n_coins; j++) {
+		const Coin& coin = coins[j];
+		IdentifiedCoinData coin_data;
+		if (!coin.decrypt_recipient_data(coin.K*incoming_view_key.get_s1(), false, decryptor, coin_data) ||
+			!incoming_view_key.get_diversifier(coin_data.d, coin_data.i)) {
+			continue;
+		}
+
+		// Coins with other parameters cannot share the fixed generators, so validate them alone
+		if (coin.params != coins[0].params) {
+			if (coin.validate(incoming_view_key, coin_data)) {
+				result[j] = coin_data;
+			}
+			continue;
+		}
+
+		CoinValidationTerms coin_terms;
+		coin_terms.index = j;
+		const PreparedDiversifier* prepared = incoming_view_key.get_prepared(coin_data.i);
+		if (prepared && prepared->d == coin_data.d) {
+			coin_terms.div = prepared->div;
+			coin_terms.Q2 = prepared->Q2;
+		} else {
+			coin_terms.div = SparkUtils::hash_div(coin_data.d);
+			coin_terms.Q2 = coin.params->mul_F(SparkUtils::hash_Q2(incoming_view_key.get_s1(), coin_data.i)) + incoming_view_key.get_incoming_view_key().get_P2();
+		}
+		coin_terms.hash_k = SparkUtils::hash_k(coin_data.k);
+		coin_terms.hash_val = SparkUtils::hash_val(coin_data.k);
+		coin_terms.hash_ser = SparkUtils::hash_ser(coin_data.k, coin.serial_context);
+
+		data.emplace_back(std::move(coin_data));
+		terms.emplace_back(coin_terms);
+	}
+	if (terms.empty()) {
+		return result;
+	}
+
+	std::vector<bool> valid(terms.size(), false);
+	validate_batch(coins, data, terms, 0, terms.size(), valid);
+	for (std::size_t t = 0; t < terms.size(); t++) {
+		if (valid[t]) {
+			result[terms[t].index] = std::move(data[t]);
+		}
+	}
+
+	return result;
+}
+
+// Decrypt and decode the recipient data, returning false if the coin was not sent to this key
+// A key commitment mismatch, the common case when scanning, is rejected without throwing
+// If the caller already checked the key commitment for this prekey, it is not derived again
+bool Coin::decrypt_recipient_data(const GroupElement& prekey, const bool key_commitment_checked, AEADDecryptor& decryptor, IdentifiedCoinData& data) const {
+	CDataStream stream(SER_NETWORK, PROTOCOL_VERSION);
+	const std::string associated_data = this->type == COIN_TYPE_MINT ? "Mint coin data" : "Spend coin data";
+	if (key_commitment_checked ?
+			!decryptor.try_decrypt(prekey, associated_data, this->r_, stream) :
+			!decryptor.try_decrypt_and_verify(prekey, associated_data, this->r_, stream)) {
+		return false;
+	}
 
 	// Deserialization means this process depends on the coin type
 	if (this->type == COIN_TYPE_MINT) {
+		// Authenticated data can still be malformed if the sender built it badly
 		MintCoinRecipientData r;
-
 		try {
-			// Decrypt recipient data
-			CDataStream stream = AEAD::decrypt_and_verify(this->K*incoming_view_key.get_s1(), "Mint coin data", this->r_);
 			stream >> r;
 		} catch (const std::exception &) {
-			throw std::runtime_error("Unable to identify coin");
+			return false;
 		}
 
         // Check that the memo length is valid
+        if (r.padded_memo.empty()) {
+            return false;
+        }
         unsigned char memo_length = r.padded_memo[0];
-        if (memo_length > this->params->get_memo_bytes()) {
-            throw std::runtime_error("Unable to identify coin");
+        if (memo_length > this->params->get_memo_bytes() || memo_length >= r.padded_memo.size()) {
+            return false;
         }
 
         data.d = r.d;
@@ -145,19 +410,19 @@ IdentifiedCoinData Coin::identify(const IncomingViewKey& incoming_view_key) {
 		data.memo = std::string(r.padded_memo.begin() + 1, r.padded_memo.begin() + 1 + memo_length); // remove the encoded length and padding;
 	} else {
 		SpendCoinRecipientData r;
-
 		try {
-			// Decrypt recipient data
-			CDataStream stream = AEAD::decrypt_and_verify(this->K*incoming_view_key.get_s1(), "Spend coin data", this->r_);
 			stream >> r;
 		} catch (const std::exception &) {
-			throw std::runtime_error("Unable to identify coin");
+			return false;
 		}
 
         // Check that the memo length is valid
+        if (r.padded_memo.empty()) {
+            return false;
+        }
         unsigned char memo_length = r.padded_memo[0];
-        if (memo_length > this->params->get_memo_bytes()) {
-            throw std::runtime_error("Unable to identify coin");
+        if (memo_length > this->params->get_memo_bytes() || memo_length >= r.padded_memo.size()) {
+            return false;
         }
 
         data.d = r.d;
@@ -166,12 +431,7 @@ IdentifiedCoinData Coin::identify(const IncomingViewKey& incoming_view_key) {
 		data.memo = std::string(r.padded_memo.begin() + 1, r.padded_memo.begin() + 1 + memo_length); // remove the encoded length and padding;
 	}
 
-	// Validate the coin
-	if (!validate(incoming_view_key, data)) {
-		throw std::runtime_error("Malformed coin");
-	}
-
-	return data;
+	return true;
 }
 
 std::size_t Coin::memoryRequired() {
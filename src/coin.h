@@ -3,6 +3,7 @@
 #include "bpplus.h"
 #include "keys.h"
 #include <math.h>
+#include <optional>
 #include "params.h"
 #include "aead.h"
 #include "util.h"
@@ -78,11 +79,32 @@ public:
 	);
 
 	// Given an incoming view key, extract the coin's nonce, diversifier, value, and memo
-	IdentifiedCoinData identify(const IncomingViewKey& incoming_view_key);
+	IdentifiedCoinData identify(const IncomingViewKey& incoming_view_key) const;
+
+	// As above, reusing decryption state across many coins on one thread
+	IdentifiedCoinData identify(const IncomingViewKey& incoming_view_key, AEADDecryptor& decryptor) const;
+
+	// As above, but returns nothing instead of throwing when the coin does not belong to the key or is malformed
+	std::optional<IdentifiedCoinData> try_identify(const IncomingViewKey& incoming_view_key) const;
+	std::optional<IdentifiedCoinData> try_identify(const IncomingViewKey& incoming_view_key, AEADDecryptor& decryptor) const;
+
+	// As above, validating with a prepared key's cached diversifier values
+	std::optional<IdentifiedCoinData> try_identify(const PreparedIncomingViewKey& incoming_view_key, AEADDecryptor& decryptor) const;
+
+	// As above, with the prekey K*s1 already computed and checked against the coin's key commitment (as when scanning)
+	std::optional<IdentifiedCoinData> try_identify(const PreparedIncomingViewKey& incoming_view_key, const GroupElement& prekey, AEADDecryptor& decryptor) const;
+
+	// Identify a batch of coins, validating every coin that decrypts with one random linear combination
+	// If the combined check fails, it is bisected to find the malformed coins
+	static std::vector<std::optional<IdentifiedCoinData>> try_identify(const PreparedIncomingViewKey& incoming_view_key, const Coin* coins, const std::size_t n_coins, AEADDecryptor& decryptor);
+	static std::vector<std::optional<IdentifiedCoinData>> try_identify(const PreparedIncomingViewKey& incoming_view_key, const std::vector<Coin>& coins, AEADDecryptor& decryptor);
 
 	// Given a full view key, extract the coin's serial number and tag
 	RecoveredCoinData recover(const FullViewKey& full_view_key, const IdentifiedCoinData& data);
 
+	// Recover a batch of coins, sharing a single scalar inversion across them
+	static std::vector<RecoveredCoinData> recover(const FullViewKey& full_view_key, const std::vector<Coin>& coins, const std::vector<IdentifiedCoinData>& data);
+
     static std::size_t memoryRequired();
 
     bool operator==(const Coin& other) const;
@@ -94,7 +116,9 @@ public:
     void setParams(const Params* params);
     void setSerialContext(const std::vector<unsigned char>& serial_context_);
 protected:
-	bool validate(const IncomingViewKey& incoming_view_key, IdentifiedCoinData& data);
+	bool decrypt_recipient_data(const GroupElement& prekey, const bool key_commitment_checked, AEADDecryptor& decryptor, IdentifiedCoinData& data) const;
+	bool validate(const IncomingViewKey& incoming_view_key, IdentifiedCoinData& data) const;
+	bool validate(const PreparedIncomingViewKey& incoming_view_key, IdentifiedCoinData& data) const;
 
 public:
 	const Params* params;
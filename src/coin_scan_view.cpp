@@ -0,0 +1,128 @@
+#include "coin_scan_view.h"
+
+namespace spark {
+
+// Read a vector length, which for a valid coin always fits in a single byte
+static bool read_size(const unsigned char* data, const std::size_t size, std::size_t& offset, std::size_t& length) {
+	if (offset >= size || data[offset] >= 253) {
+		return false;
+	}
+	length = data[offset++];
+
+	return true;
+}
+
+// Skip a serialized vector, checking its length
+static bool skip_vector(const unsigned char* data, const std::size_t size, std::size_t& offset, const std::size_t expected) {
+	std::size_t length;
+	if (!read_size(data, size, offset, length) || length != expected || size - offset < length) {
+		return false;
+	}
+	offset += length;
+
+	return true;
+}
+
+CoinScanView::CoinScanView(const unsigned char* data_, const std::size_t size)
+	: data(data_)
+{
+	const Params* params = Params::get_default();
+	const std::size_t POINT_SIZE = GroupElement::serialize_size;
+
+	// Type, then the serial commitment, recovery key, and value commitment
+	if (size < 1 + 3*POINT_SIZE) {
+		throw std::invalid_argument("Cannot parse coin due to bad size");
+	}
+	this->type = (char) data[0];
+	if (this->type != COIN_TYPE_MINT && this->type != COIN_TYPE_SPEND) {
+		throw std::invalid_argument("Cannot parse coin due to bad type");
+	}
+	this->K.deserialize(data + 1 + POINT_SIZE);
+	std::size_t offset = 1 + 3*POINT_SIZE;
+
+	// Encrypted recipient data, whose sizes are fixed by the coin type
+	std::size_t ciphertext_size = (1 + AES_BLOCKSIZE) + SCALAR_ENCODING + (1 + params->get_memo_bytes() + 1);
+	if (this->type == COIN_TYPE_SPEND) {
+		ciphertext_size += 8;
+	}
+	if (!skip_vector(data, size, offset, ciphertext_size) || !skip_vector(data, size, offset, AEAD_TAG_SIZE)) {
+		throw std::invalid_argument("Cannot parse coin due to bad encrypted data");
+	}
+	this->key_commitment = data + offset + 1;
+	if (!skip_vector(data, size, offset, AEAD_COMMIT_SIZE)) {
+		throw std::invalid_argument("Cannot parse coin due to bad key commitment");
+	}
+
+	// Mint coins carry a public value
+	if (this->type == COIN_TYPE_MINT) {
+		if (size - offset < sizeof(uint64_t)) {
+			throw std::invalid_argument("Cannot parse coin due to bad size");
+		}
+		offset += sizeof(uint64_t);
+	}
+
+	this->encoded_size = offset;
+}
+
+char CoinScanView::get_type() const {
+	return this->type;
+}
+
+const GroupElement& CoinScanView::get_K() const {
+	return this->K;
+}
+
+std::size_t CoinScanView::get_encoded_size() const {
+	return this->encoded_size;
+}
+
+bool CoinScanView::matches(const Scalar& s1, AEADDecryptor& decryptor) const {
+	return decryptor.check_key_commitment(this->K*s1, this->key_commitment);
+}
+
+Coin CoinScanView::decode() const {
+	const std::size_t POINT_SIZE = GroupElement::serialize_size;
+	CDataStream stream(
+		reinterpret_cast<const char*>(this->data + 1),
+		reinterpret_cast<const char*>(this->data + this->encoded_size),
+		SER_NETWORK,
+		PROTOCOL_VERSION
+	);
+
+	// The layout and sizes were checked when the view was parsed
+	Coin coin(Params::get_default());
+	coin.type = this->type;
+	stream >> coin.S;
+	stream.ignore(POINT_SIZE);
+	coin.K = this->K;
+	stream >> coin.C;
+	stream >> coin.r_;
+	if (this->type == COIN_TYPE_MINT) {
+		stream >> coin.v;
+	}
+
+	return coin;
+}
+
+std::optional<IdentifiedCoinData> CoinScanView::try_identify(
+	const PreparedIncomingViewKey& incoming_view_key,
+	AEADDecryptor& decryptor,
+	const std::vector<unsigned char>& serial_context,
+	Coin& coin) const {
+	const GroupElement prekey = this->K*incoming_view_key.get_s1();
+	if (!decryptor.check_key_commitment(prekey, this->key_commitment)) {
+		return std::nullopt;
+	}
+
+	// The key matches, so the remaining points are worth decompressing
+	try {
+		coin = decode();
+	} catch (const std::exception &) {
+		return std::nullopt;
+	}
+	coin.setSerialContext(serial_context);
+
+	return coin.try_identify(incoming_view_key, prekey, decryptor);
+}
+
+}
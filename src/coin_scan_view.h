@@ -0,0 +1,45 @@
+#ifndef FIRO_SPARK_COIN_SCAN_VIEW_H
+#define FIRO_SPARK_COIN_SCAN_VIEW_H
+#include "coin.h"
+
+namespace spark {
+
+using namespace secp_primitives;
+
+// Scan-only view of a serialized coin, parsed in place
+// Only the recovery key is decompressed; the full coin is decoded once the AEAD key commitment matches
+// The serialized bytes are borrowed and must outlive the view
+class CoinScanView {
+public:
+	// Throws std::invalid_argument if the bytes are not a well-formed coin encoding
+	CoinScanView(const unsigned char* data, const std::size_t size);
+
+	char get_type() const;
+	const GroupElement& get_K() const;
+	std::size_t get_encoded_size() const;
+
+	// Whether the coin's key commitment matches the key, without decrypting or decoding the coin
+	bool matches(const Scalar& s1, AEADDecryptor& decryptor) const;
+
+	// Decode the full coin from the viewed bytes, reusing the already decompressed recovery key
+	Coin decode() const;
+
+	// Identify the coin, decoding it into `coin` (with its serial context) only if the key commitment matches
+	// The prekey computed for the commitment check is reused to decrypt, so K*s1 and the commitment are computed once
+	std::optional<IdentifiedCoinData> try_identify(
+		const PreparedIncomingViewKey& incoming_view_key,
+		AEADDecryptor& decryptor,
+		const std::vector<unsigned char>& serial_context,
+		Coin& coin) const;
+
+private:
+	const unsigned char* data;
+	std::size_t encoded_size;
+	char type;
+	GroupElement K;
+	const unsigned char* key_commitment;
+};
+
+}
+
+#endif
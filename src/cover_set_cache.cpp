@@ -0,0 +1,57 @@
+#include "cover_set_cache.h"
+
+namespace spark {
+
+std::shared_ptr<const CoverSetPoints> CoverSetCache::get(uint64_t cover_set_id, const std::vector<Coin>& cover_set) {
+	const std::size_t size = cover_set.size();
+	if (size == 0) {
+		return std::make_shared<const CoverSetPoints>();
+	}
+
+	LOCK(cs_sets);
+	std::shared_ptr<const CoverSetPoints>& cached = sets[cover_set_id];
+	const std::size_t reused = cached ? cached->S.size() : 0;
+	if (reused >= size) {
+		return cached;
+	}
+
+	// Extend the entry, normalizing only the new elements
+	std::shared_ptr<CoverSetPoints> extended = std::make_shared<CoverSetPoints>();
+	extended->S.reserve(size);
+	extended->C.reserve(size);
+	if (reused > 0) {
+		extended->S.assign(cached->S.begin(), cached->S.end());
+		extended->C.assign(cached->C.begin(), cached->C.end());
+	}
+	for (std::size_t i = reused; i < size; i++) {
+		extended->S.emplace_back(cover_set[i].S);
+		extended->C.emplace_back(cover_set[i].C);
+	}
+	GroupElement::batch_normalize(extended->S.data() + reused, size - reused);
+	GroupElement::batch_normalize(extended->C.data() + reused, size - reused);
+
+	cached = extended;
+	return cached;
+}
+
+std::shared_ptr<const CoverSetPoints> CoverSetCache::find(uint64_t cover_set_id, std::size_t size) {
+	LOCK(cs_sets);
+	auto it = sets.find(cover_set_id);
+	if (it == sets.end() || !it->second || it->second->S.size() < size) {
+		return nullptr;
+	}
+
+	return it->second;
+}
+
+void CoverSetCache::erase(uint64_t cover_set_id) {
+	LOCK(cs_sets);
+	sets.erase(cover_set_id);
+}
+
+void CoverSetCache::clear() {
+	LOCK(cs_sets);
+	sets.clear();
+}
+
+}
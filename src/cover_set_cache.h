@@ -0,0 +1,42 @@
+#ifndef FIRO_SPARK_COVER_SET_CACHE_H
+#define FIRO_SPARK_COVER_SET_CACHE_H
+#include "coin.h"
+#include <memory>
+#include <unordered_map>
+
+namespace spark {
+
+using namespace secp_primitives;
+
+// Serial commitments and value commitments of a cover set, as contiguous normalized arrays
+struct CoverSetPoints {
+	std::vector<GroupElement> S;
+	std::vector<GroupElement> C;
+};
+
+// Cache of preprocessed cover set points shared across verification calls, keyed by cover set id and size
+// Cover sets are monotonic, so a set's first elements never change while it grows: a lookup for a size the
+// entry already covers is served without looking at the coins, and a larger size only processes the new tail
+// Normalized points reach the multiexponentiation already affine, which skips its per-point inversion
+// Entries are immutable once published, so callers may keep using a returned entry while others extend the set
+class CoverSetCache {
+public:
+	// Returns points covering at least `cover_set`; only the first `cover_set.size()` elements apply to it
+	std::shared_ptr<const CoverSetPoints> get(uint64_t cover_set_id, const std::vector<Coin>& cover_set);
+
+	// Returns points covering at least `size` elements of the set, or nothing if they are not cached yet
+	std::shared_ptr<const CoverSetPoints> find(uint64_t cover_set_id, std::size_t size);
+
+	// Drop entries whose sets changed other than by growth; this must be called for every set a reorganization
+	// touches, since lookups do not recheck cached elements against the coins
+	void erase(uint64_t cover_set_id);
+	void clear();
+
+private:
+	CCriticalSection cs_sets;
+	std::unordered_map<uint64_t, std::shared_ptr<const CoverSetPoints>> sets;
+};
+
+}
+
+#endif
@@ -1,6 +1,8 @@
 #include "grootle.h"
 #include "transcript.h"
 
+#include <thread>
+
 namespace spark {
 
 // Useful scalar constants
@@ -19,6 +21,7 @@ Grootle::Grootle(
         , Hi (Hi_)
         , n (n_)
         , m (m_)
+        , transcript_prefix (LABEL_TRANSCRIPT_GROOTLE)
 {
     if (!(n > 1 && m > 1)) {
         throw std::invalid_argument("Bad Grootle size parameters!");
@@ -26,6 +29,30 @@ Grootle::Grootle(
     if (Gi.size() != n*m || Hi.size() != n*m) {
         throw std::invalid_argument("Bad Grootle generator size!");
     }
+
+    // The transcript prefix depends only on fixed parameters
+    transcript_prefix.add("H", H);
+    transcript_prefix.add("Gi", Gi);
+    transcript_prefix.add("Hi", Hi);
+    transcript_prefix.add("n", Scalar(n));
+    transcript_prefix.add("m", Scalar(m));
+}
+
+Grootle::Grootle(
+        const GroupElement& H_,
+        const std::vector<GroupElement>& Gi_,
+        const std::vector<GroupElement>& Hi_,
+        const FixedMultiExponent& Gi_table_,
+        const FixedMultiExponent& Hi_table_,
+        const std::size_t n_,
+        const std::size_t m_)
+        : Grootle(H_, Gi_, Hi_, n_, m_)
+{
+    if (Gi_table_.size() != n*m || Hi_table_.size() != n*m) {
+        throw std::invalid_argument("Bad Grootle generator table size!");
+    }
+    Gi_table = &Gi_table_;
+    Hi_table = &Hi_table_;
 }
 
 // Compute a delta function vector
@@ -62,10 +89,13 @@ static inline std::vector<std::size_t> decompose(std::size_t num, const std::siz
 }
 
 // Compute a double Pedersen vector commitment
-static inline GroupElement vector_commit(const std::vector<GroupElement>& Gi, const std::vector<GroupElement>& Hi, const std::vector<Scalar>& a, const std::vector<Scalar>& b, const GroupElement& H, const Scalar& r) {
+GroupElement Grootle::vector_commit(const std::vector<Scalar>& a, const std::vector<Scalar>& b, const Scalar& r) const {
     if (Gi.size() != a.size() || Hi.size() != b.size()) {
         throw std::runtime_error("Vector commitment size mismatch!");
     }
+    if (Gi_table && Hi_table) {
+        return Gi_table->get_multiple(a) + Hi_table->get_multiple(b) + H*r;
+    }
     return secp_primitives::MultiExponent(Gi, a).get_multiple() + secp_primitives::MultiExponent(Hi, b).get_multiple() + H*r;
 }
 
@@ -110,34 +140,36 @@ static bool compute_fs(
     return true;
 }
 
+// Expand the f-matrix into the first `count` tensor products prod_j f[j][i_j], each scaled by `weight`
+// Digits are applied from the highest down, so each level only expands the nodes that lead to needed leaves
 static void compute_batch_fis(
-        Scalar& f_sum,
-        const Scalar& f_i,
-        int j,
         const std::vector<Scalar>& f,
-        const Scalar& y,
-        std::vector<Scalar>::iterator& ptr,
-        std::vector<Scalar>::iterator start_ptr,
-        std::vector<Scalar>::iterator end_ptr,
-        const std::size_t n) {
-    j--;
-    if (j == -1)
-    {
-        if(ptr >= start_ptr && ptr < end_ptr){
-            *ptr++ += f_i * y;
-            f_sum += f_i;
-        }
+        const Scalar& weight,
+        const std::size_t n,
+        const std::size_t m,
+        const std::size_t count,
+        std::vector<Scalar>& fis) {
+    fis.resize(std::max(fis.size(), count));
+    if (count == 0) {
         return;
     }
 
-    Scalar t;
+    // Leaves below each node at the current level
+    std::size_t span = 1;
+    for (std::size_t j = 0; j < m; j++) {
+        span *= n;
+    }
 
-    for (std::size_t i = 0; i < n; i++)
-    {
-        t = f[j * n + i];
-        t *= f_i;
+    fis[0] = weight;
+    for (std::ptrdiff_t j = m - 1; j >= 0; j--) {
+        span /= n;
+        const std::size_t nodes = (count + span - 1) / span;
+        const Scalar* f_j = &f[j*n];
 
-        compute_batch_fis(f_sum, t, j, f, y, ptr, start_ptr, end_ptr, n);
+        // In place, from the end, so every parent is read before it is overwritten
+        for (std::size_t k = nodes; k-- > 0; ) {
+            fis[k] = fis[k / n] * f_j[k % n];
+        }
     }
 }
 
@@ -150,7 +182,8 @@ void Grootle::prove(
         const std::vector<GroupElement>& V,
         const GroupElement& V1,
         const std::vector<unsigned char>& root,
-        GrootleProof& proof) {
+        GrootleProof& proof,
+        ThreadPool* thread_pool) const {
     // Check statement validity
     std::size_t N = (std::size_t) pow(n, m); // padded input size
     std::size_t size = S.size(); // actual input size
@@ -171,12 +204,7 @@ void Grootle::prove(
     }
 
     // Set up transcript
-    Transcript transcript(LABEL_TRANSCRIPT_GROOTLE);
-    transcript.add("H", H);
-    transcript.add("Gi", Gi);
-    transcript.add("Hi", Hi);
-    transcript.add("n", Scalar(n));
-    transcript.add("m", Scalar(m));
+    Transcript transcript(transcript_prefix);
     transcript.add("root", root);
     transcript.add("S1", S1);
     transcript.add("V1", V1);
@@ -197,7 +225,7 @@ void Grootle::prove(
     }
     Scalar rA;
     rA.randomize();
-    proof.A = vector_commit(Gi, Hi, a, d, H, rA);
+    proof.A = vector_commit(a, d, rA);
 
     // Compute B
     std::vector<Scalar> sigma = convert_to_sigma(l, n, m);
@@ -208,20 +236,61 @@ void Grootle::prove(
     }
     Scalar rB;
     rB.randomize();
-    proof.B = vector_commit(Gi, Hi, sigma, c, H, rB);
+    proof.B = vector_commit(sigma, c, rB);
 
     // Compute convolution terms
-    std::vector<std::vector<Scalar>> P_i_j;
-    P_i_j.resize(size);
-    for (std::size_t i = 0; i < size - 1; ++i)
-    {
-        std::vector<Scalar>& coefficients = P_i_j[i];
-        std::vector<std::size_t> I = decompose(i, n, m);
-        coefficients.push_back(a[I[0]]);
-        coefficients.push_back(sigma[I[0]]);
-        for (std::size_t j = 1; j < m; ++j) {
-            convolve(sigma[j*n + I[j]], a[j*n + I[j]], coefficients);
+    // The coefficient of x^j in p_i(x) is stored at P[j*size + i], so each digit's coefficients are contiguous
+    std::vector<std::size_t> lj = decompose(l, n, m);
+    std::vector<Scalar> P(m * size);
+    auto compute_coefficients = [&](std::size_t begin, std::size_t end) {
+        if (begin >= end) {
+            return;
+        }
+
+        // prefix[k] holds the product of the factors for the top k digits, with k + 1 coefficients
+        // Walking the indexes in order only changes low digits, so the higher prefixes are shared
+        std::vector<Scalar> prefix((m + 1) * (m + 1));
+        prefix[0] = ONE;
+        std::vector<std::size_t> digits = decompose(begin, n, m);
+        std::size_t valid = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            for (std::size_t k = valid + 1; k <= m; k++) {
+                // Multiply by (\delta_{l_j,i_j}x + a_{j,i_j}) for digit j
+                const std::size_t j = m - k;
+                const Scalar& a_j = a[j*n + digits[j]];
+                const Scalar* previous = &prefix[(k - 1) * (m + 1)];
+                Scalar* current = &prefix[k * (m + 1)];
+                current[k] = ZERO;
+                for (std::size_t d = 0; d < k; d++) {
+                    current[d] = a_j * previous[d];
+                }
+                if (digits[j] == lj[j]) {
+                    for (std::size_t d = 0; d < k; d++) {
+                        current[d + 1] += previous[d];
+                    }
+                }
+            }
+            const Scalar* product = &prefix[m * (m + 1)];
+            for (std::size_t j = 0; j < m; j++) {
+                P[j*size + i] = product[j];
+            }
+
+            // Increment the digits; only prefixes over unchanged high digits stay valid
+            std::size_t t = 0;
+            while (t < m && ++digits[t] == n) {
+                digits[t++] = 0;
+            }
+            valid = t < m ? m - t - 1 : 0;
         }
+    };
+    if (thread_pool) {
+        const std::size_t chunks = thread_pool->size() + 1;
+        const std::size_t chunk = (size - 1 + chunks - 1) / chunks;
+        thread_pool->parallel_for(chunks, [&](std::size_t c) {
+            compute_coefficients(std::min(c * chunk, size - 1), std::min((c + 1) * chunk, size - 1));
+        });
+    } else {
+        compute_coefficients(0, size - 1);
     }
 
     /*
@@ -243,7 +312,6 @@ void Grootle::prove(
      */
 
     std::vector<std::size_t> I = decompose(size - 1, n, m);
-    std::vector<std::size_t> lj = decompose(l, n, m);
 
     std::vector<Scalar> p_i_sum;
     p_i_sum.emplace_back(ONE);
@@ -271,19 +339,15 @@ void Grootle::prove(
             p_i_sum[j + k] += polynomial[k];
     }
 
-    P_i_j[size - 1] = p_i_sum;
-
-    // Perform the commitment offsets
-    std::vector<GroupElement> S_offset(S);
-    std::vector<GroupElement> V_offset(V);
-    GroupElement S1_inverse = S1.inverse();
-    GroupElement V1_inverse = V1.inverse();
-    for (std::size_t k = 0; k < S_offset.size(); k++) {
-        S_offset[k] += S1_inverse;
-        V_offset[k] += V1_inverse;
+    for (std::size_t j = 0; j < m; j++) {
+        P[j*size + size - 1] = p_i_sum[j];
+    }
 
-        // Neither should be zero
-        if (S_offset[k].isInfinity() || V_offset[k].isInfinity()) {
+    // The offsets are applied once per j rather than to every element, since
+    // sum_i P_i[j]*(S_i - S1) = sum_i P_i[j]*S_i - (sum_i P_i[j])*S1 and likewise for V
+    for (std::size_t k = 0; k < size; k++) {
+        // Neither offset commitment should be zero
+        if (S[k] == S1 || V[k] == V1) {
             throw std::invalid_argument("Commitment offset should not be zero");
         }
     }
@@ -297,23 +361,41 @@ void Grootle::prove(
         rho_V[j].randomize();
     }
 
+    // All m digit polynomials share the S and V bases, so each set is evaluated in one pass
+    std::vector<Scalar> P_sum;
+    P_sum.resize(m);
+    for (std::size_t j = 0; j < m; ++j) {
+        for (std::size_t i = 0; i < size; ++i) {
+            P_sum[j] += P[j*size + i];
+        }
+        P_sum[j] = P_sum[j].negate();
+    }
+    std::vector<GroupElement> X_S, X_V;
+    if (thread_pool) {
+        // Split the digits into groups so every thread gets a share of the S and V passes;
+        // the group count is recomputed from the rounded-up size so no group is empty
+        const std::size_t max_groups = std::min(m, (thread_pool->size() + 2) / 2);
+        const std::size_t group_size = (m + max_groups - 1) / max_groups;
+        const std::size_t groups = (m + group_size - 1) / group_size;
+        X_S.resize(m);
+        X_V.resize(m);
+        thread_pool->parallel_for(2 * groups, [&](std::size_t task) {
+            const std::size_t begin = (task / 2) * group_size;
+            const std::size_t end = std::min(begin + group_size, m);
+            const std::vector<GroupElement>& bases = task % 2 == 0 ? S : V;
+            std::vector<GroupElement> results = secp_primitives::MultiExponent::get_multiples(bases.data(), size, P.data() + begin*size, end - begin);
+            std::copy(results.begin(), results.end(), (task % 2 == 0 ? X_S : X_V).begin() + begin);
+        });
+    } else {
+        X_S = secp_primitives::MultiExponent::get_multiples(S.data(), size, P.data(), m);
+        X_V = secp_primitives::MultiExponent::get_multiples(V.data(), size, P.data(), m);
+    }
+
     proof.X.reserve(m);
     proof.X1.reserve(m);
-    for (std::size_t j = 0; j < m; ++j)
-    {
-        std::vector<Scalar> P_i;
-        P_i.reserve(size);
-        for (std::size_t i = 0; i < size; ++i){
-            P_i.emplace_back(P_i_j[i][j]);
-        }
-        
-        // S
-        secp_primitives::MultiExponent mult_S(S_offset, P_i);
-        proof.X.emplace_back(mult_S.get_multiple() + H*rho_S[j]);
-        
-        // V
-        secp_primitives::MultiExponent mult_V(V_offset, P_i);
-        proof.X1.emplace_back(mult_V.get_multiple() + H*rho_V[j]);
+    for (std::size_t j = 0; j < m; ++j) {
+        proof.X.emplace_back(X_S[j] + S1*P_sum[j] + H*rho_S[j]);
+        proof.X1.emplace_back(X_V[j] + V1*P_sum[j] + H*rho_V[j]);
     }
 
     // Challenge
@@ -361,7 +443,7 @@ bool Grootle::verify(
         const GroupElement& V1,
         const std::vector<unsigned char>& root,
         const std::size_t size,
-        const GrootleProof& proof) {
+        const GrootleProof& proof) const {
     std::vector<GroupElement> S1_batch = {S1};
     std::vector<GroupElement> V1_batch = {V1};
     std::vector<std::size_t> size_batch = {size};
@@ -379,7 +461,104 @@ bool Grootle::verify(
         const std::vector<GroupElement>& V1,
         const std::vector<std::vector<unsigned char>>& roots,
         const std::vector<std::size_t>& sizes,
-        const std::vector<GrootleProof>& proofs) {
+        const std::vector<GrootleProof>& proofs,
+        ThreadPool* thread_pool) const {
+    if (S.size() != V.size()) {
+//        LogPrintf("Commitment set sizes do not match");
+        return false;
+    }
+
+    return verify(S.data(), V.data(), S.size(), S1, V1, roots, sizes, proofs, thread_pool);
+}
+
+// Verify a batch of proofs against the first `commits_size` elements of the commitment arrays
+bool Grootle::verify(
+        const GroupElement* S,
+        const GroupElement* V,
+        const std::size_t commits_size,
+        const std::vector<GroupElement>& S1,
+        const std::vector<GroupElement>& V1,
+        const std::vector<std::vector<unsigned char>>& roots,
+        const std::vector<std::size_t>& sizes,
+        const std::vector<GrootleProof>& proofs,
+        ThreadPool* thread_pool) const {
+    Scalar H_scalar;
+    std::vector<Scalar> Gi_scalars(n*m);
+    std::vector<Scalar> Hi_scalars(n*m);
+    std::vector<GroupElement> points;
+    std::vector<Scalar> scalars;
+    if (!accumulate(S, V, commits_size, S1, V1, roots, sizes, proofs, H_scalar, Gi_scalars, Hi_scalars, points, scalars)) {
+        return false;
+    }
+
+    return verify_accumulated(H_scalar, Gi_scalars, Hi_scalars, points, scalars, thread_pool);
+}
+
+// Verify batches of proofs over distinct commitment sets with a single multiscalar multiplication
+// Every proof already carries its own random weights, so the batches can share the common generator scalars
+bool Grootle::verify(const std::vector<GrootleStatement>& statements, ThreadPool* thread_pool) const {
+    if (statements.empty()) {
+        return false;
+    }
+
+    std::size_t final_size = 1 + 2*m*n; // F, (Gi), (Hi)
+    for (const GrootleStatement& statement : statements) {
+        final_size += batch_size(statement.commits_size, statement.proofs);
+    }
+
+    Scalar H_scalar;
+    std::vector<Scalar> Gi_scalars(n*m);
+    std::vector<Scalar> Hi_scalars(n*m);
+    std::vector<GroupElement> points;
+    std::vector<Scalar> scalars;
+    points.reserve(final_size);
+    scalars.reserve(final_size);
+    for (const GrootleStatement& statement : statements) {
+        if (!accumulate(
+                statement.S,
+                statement.V,
+                statement.commits_size,
+                statement.S1,
+                statement.V1,
+                statement.roots,
+                statement.sizes,
+                statement.proofs,
+                H_scalar,
+                Gi_scalars,
+                Hi_scalars,
+                points,
+                scalars)) {
+            return false;
+        }
+    }
+
+    return verify_accumulated(H_scalar, Gi_scalars, Hi_scalars, points, scalars, thread_pool);
+}
+
+// Number of points a batch contributes to the final multiscalar multiplication, excluding common generators
+std::size_t Grootle::batch_size(const std::size_t commits_size, const std::vector<GrootleProof>& proofs) {
+    std::size_t size = 2*commits_size; // (S), (V)
+    for (const GrootleProof& proof : proofs) {
+        size += 4 + proof.X.size() + proof.X1.size(); // A, B, S1, V1, (X), (X1)
+    }
+    return size;
+}
+
+// Check a batch of proofs and add its terms to a final multiscalar multiplication
+bool Grootle::accumulate(
+        const GroupElement* S,
+        const GroupElement* V,
+        const std::size_t commits_size,
+        const std::vector<GroupElement>& S1,
+        const std::vector<GroupElement>& V1,
+        const std::vector<std::vector<unsigned char>>& roots,
+        const std::vector<std::size_t>& sizes,
+        const std::vector<GrootleProof>& proofs,
+        Scalar& H_scalar,
+        std::vector<Scalar>& Gi_scalars,
+        std::vector<Scalar>& Hi_scalars,
+        std::vector<GroupElement>& points,
+        std::vector<Scalar>& scalars) const {
     // Sanity checks
     if (n < 2 || m < 2) {
 //        LogPrintf("Verifier parameters are invalid");
@@ -388,18 +567,14 @@ bool Grootle::verify(
     std::size_t M = proofs.size();
     std::size_t N = (std::size_t)pow(n, m);
 
-    if (S.size() == 0) {
+    if (commits_size == 0) {
 //        LogPrintf("Cannot have empty commitment set");
         return false;
     }
-    if (S.size() > N) {
+    if (commits_size > N) {
 //        LogPrintf("Commitment set is too large");
         return false;
     }
-    if (S.size() != V.size()) {
-//        LogPrintf("Commitment set sizes do not match");
-        return false;
-    }
     if (S1.size() != M || V1.size() != M) {
 //        LogPrintf("Invalid number of offsets provided");
         return false;
@@ -415,7 +590,7 @@ bool Grootle::verify(
 
     // Check proof semantics
     for (std::size_t t = 0; t < M; t++) {
-        GrootleProof proof = proofs[t];
+        const GrootleProof& proof = proofs[t];
         if (proof.X.size() != m || proof.X1.size() != m) {
 //            LogPrintf("Bad proof vector size!");
             return false;
@@ -424,6 +599,10 @@ bool Grootle::verify(
 //            LogPrintf("Bad proof vector size!");
             return false;
         }
+        if (sizes[t] == 0 || sizes[t] > commits_size) {
+//            LogPrintf("Bad effective set size!");
+            return false;
+        }
     }
 
     // Commitment binding weight; intentionally restricted range for efficiency, but must be nonzero
@@ -435,51 +614,27 @@ bool Grootle::verify(
         bind_weight = Scalar(distribution(generator));
     }
 
-    // Bind the commitment lists
-    std::vector<GroupElement> commits;
-    commits.reserve(S.size());
-    for (std::size_t i = 0; i < S.size(); i++) {
-        commits.emplace_back(S[i] + V[i]*bind_weight);
-    }
+    // The commitment lists are bound as S + V*bind_weight, but S and V enter the
+    // final multiscalar multiplication separately instead of being combined up front
 
-    // Final batch multiscalar multiplication
-    Scalar H_scalar;
-    std::vector<Scalar> Gi_scalars;
-    std::vector<Scalar> Hi_scalars;
     std::vector<Scalar> commit_scalars;
-    Gi_scalars.resize(n*m);
-    Hi_scalars.resize(n*m);
-    commit_scalars.resize(commits.size());
+    commit_scalars.resize(commits_size);
 
-    // Set up the final batch elements
-    std::vector<GroupElement> points;
-    std::vector<Scalar> scalars;
-    std::size_t final_size = 1 + 2*m*n + commits.size(); // F, (Gi), (Hi), (commits)
-    for (std::size_t t = 0; t < M; t++) {
-        final_size += 2 + proofs[t].X.size() + proofs[t].X1.size(); // A, B, (Gs), (Gv)
-    }
+    // Set up the batch elements; the common generators are added once all batches are in
+    const std::size_t final_size = points.size() + batch_size(commits_size, proofs) + 1 + 2*m*n;
     points.reserve(final_size);
     scalars.reserve(final_size);
 
-    // Index decomposition, which is common among all proofs
-    std::vector<std::vector<std::size_t> > I_;
-    I_.reserve(commits.size());
-    I_.resize(commits.size());
-    for (std::size_t i = 0; i < commits.size(); i++) {
-        I_[i] = decompose(i, n, m);
-    }
+    // Tensor product buffer, reused across proofs
+    std::vector<Scalar> fis;
+    fis.reserve(commits_size);
 
     // Process all proofs
     for (std::size_t t = 0; t < M; t++) {
-        GrootleProof proof = proofs[t];
+        const GrootleProof& proof = proofs[t];
 
         // Reconstruct the challenge
-        Transcript transcript(LABEL_TRANSCRIPT_GROOTLE);
-        transcript.add("H", H);
-        transcript.add("Gi", Gi);
-        transcript.add("Hi", Hi);
-        transcript.add("n", Scalar(n));
-        transcript.add("m", Scalar(m));
+        Transcript transcript(transcript_prefix);
         transcript.add("root", roots[t]);
         transcript.add("S1", S1[t]);
         transcript.add("V1", V1[t]);
@@ -519,33 +674,43 @@ bool Grootle::verify(
         // Input sets
         H_scalar += (proof.zS + bind_weight * proof.zV) * w2.negate();
 
-        Scalar f_sum;
-        Scalar f_i(uint64_t(1));
-        std::vector<Scalar>::iterator ptr = commit_scalars.begin() + commits.size() - size;
-        compute_batch_fis(f_sum, f_i, m, f_, w2, ptr, ptr, ptr + size - 1, n);
+        // The weighted tensor products go straight into the commitment scalars
+        Scalar weighted_sum;
+        compute_batch_fis(f_, w2, n, m, size - 1, fis);
+        Scalar* commit_ptr = &commit_scalars[commits_size - size];
+        for (std::size_t i = 0; i < size - 1; i++) {
+            commit_ptr[i] += fis[i];
+            weighted_sum += fis[i];
+        }
 
+        // Index decomposition of the last element, which stands in for the padding
+        std::vector<std::size_t> I = decompose(size - 1, n, m);
         Scalar pow(uint64_t(1));
         std::vector<Scalar> f_part_product;
         for (std::ptrdiff_t j = m - 1; j >= 0; j--) {
             f_part_product.push_back(pow);
-            pow *= f_[j*n + I_[size - 1][j]];
+            pow *= f_[j*n + I[j]];
         }
 
         Scalar x_powers(uint64_t(1));
         for (std::size_t j = 0; j < m; j++) {
             Scalar fi_sum(uint64_t(0));
-            for (std::size_t i = I_[size - 1][j] + 1; i < n; i++)
+            for (std::size_t i = I[j] + 1; i < n; i++)
                 fi_sum += f_[j*n + i];
             pow += fi_sum * x_powers * f_part_product[m - j - 1];
             x_powers *= x;
         }
 
-        f_sum += pow;
-        commit_scalars[commits.size() - 1] += pow * w2;
+        Scalar pow_weighted = pow * w2;
+        weighted_sum += pow_weighted;
+        commit_scalars[commits_size - 1] += pow_weighted;
 
         // S1, V1
-        points.emplace_back(S1[t] + V1[t] * bind_weight);
-        scalars.emplace_back(f_sum * w2.negate());
+        Scalar offset_scalar = weighted_sum.negate();
+        points.emplace_back(S1[t]);
+        scalars.emplace_back(offset_scalar);
+        points.emplace_back(V1[t]);
+        scalars.emplace_back(offset_scalar * bind_weight);
 
         // (X), (X1)
         x_powers = Scalar(uint64_t(1));
@@ -553,32 +718,66 @@ bool Grootle::verify(
             if (x_powers.isZero()) {
                 return false;
             }
-            points.emplace_back(proof.X[j] + proof.X1[j] * bind_weight);
-            scalars.emplace_back(x_powers.negate() * w2);
+            Scalar X_scalar = x_powers.negate() * w2;
+            points.emplace_back(proof.X[j]);
+            scalars.emplace_back(X_scalar);
+            points.emplace_back(proof.X1[j]);
+            scalars.emplace_back(X_scalar * bind_weight);
             x_powers *= x;
         }
     }
 
+    for (std::size_t i = 0; i < commits_size; i++) {
+        points.emplace_back(S[i]);
+        scalars.emplace_back(commit_scalars[i]);
+        points.emplace_back(V[i]);
+        scalars.emplace_back(commit_scalars[i] * bind_weight);
+    }
+
+    return true;
+}
+
+// Add the common generators to accumulated batches and check the final multiscalar multiplication
+bool Grootle::verify_accumulated(
+        const Scalar& H_scalar,
+        const std::vector<Scalar>& Gi_scalars,
+        const std::vector<Scalar>& Hi_scalars,
+        std::vector<GroupElement>& points,
+        std::vector<Scalar>& scalars,
+        ThreadPool* thread_pool) const {
     // Add common generators
     points.emplace_back(H);
     scalars.emplace_back(H_scalar);
-    for (std::size_t i = 0; i < m * n; i++) {
-        points.emplace_back(Gi[i]);
-        scalars.emplace_back(Gi_scalars[i]);
-        points.emplace_back(Hi[i]);
-        scalars.emplace_back(Hi_scalars[i]);
-    }
-    for (std::size_t i = 0; i < commits.size(); i++) {
-        points.emplace_back(commits[i]);
-        scalars.emplace_back(commit_scalars[i]);
+    if (Gi_table && Hi_table) {
+        points.emplace_back(Gi_table->get_multiple(Gi_scalars) + Hi_table->get_multiple(Hi_scalars));
+        scalars.emplace_back(ONE);
+    } else {
+        for (std::size_t i = 0; i < m * n; i++) {
+            points.emplace_back(Gi[i]);
+            scalars.emplace_back(Gi_scalars[i]);
+            points.emplace_back(Hi[i]);
+            scalars.emplace_back(Hi_scalars[i]);
+        }
     }
 
-    // Verify the batch
+    // Verify the batch, splitting the multiexponentiation into ranges on the pool if one is given
     secp_primitives::MultiExponent result(points, scalars);
-    if (result.get_multiple().isInfinity()) {
-        return true;
-    }
-    return false;
+    const std::size_t ranges = thread_pool ? secp_primitives::MultiExponent::split_count(points.size(), thread_pool->size() + 1) : 1;
+    if (ranges == 1) {
+        return result.get_multiple().isInfinity();
+    }
+
+    std::vector<GroupElement> partial(ranges);
+    const std::size_t range_size = (points.size() + ranges - 1) / ranges;
+    thread_pool->parallel_for(ranges, [&](std::size_t r) {
+        const std::size_t begin = std::min(r*range_size, points.size());
+        partial[r] = result.get_partial_multiple(begin, std::min(begin + range_size, points.size()));
+    });
+    GroupElement sum;
+    for (const GroupElement& p : partial) {
+        sum += p;
+    }
+    return sum.isInfinity();
 }
 
 }
\ No newline at end of file
@@ -3,22 +3,50 @@
 
 #include "grootle_proof.h"
 #include "../secp256k1/include/MultiExponent.h"
+#include "../secp256k1/include/FixedMultiExponent.h"
 #include <random>
 #include "util.h"
+#include "thread_pool.h"
+#include "transcript.h"
 
 namespace spark {
 
+// A batch of proofs sharing a commitment set, for verification alongside batches over other sets
+// Only the first `commits_size` elements of `S` and `V` are used, and they must outlive verification
+struct GrootleStatement {
+    const GroupElement* S;
+    const GroupElement* V;
+    std::size_t commits_size;
+    std::vector<GroupElement> S1;
+    std::vector<GroupElement> V1;
+    std::vector<std::vector<unsigned char>> roots;
+    std::vector<std::size_t> sizes;
+    std::vector<GrootleProof> proofs;
+};
+
 class Grootle {
 
 public:
+    // Generators and tables are referenced rather than copied, so they must outlive the instance
+    Grootle(
+        const GroupElement& H,
+        const std::vector<GroupElement>& Gi,
+        const std::vector<GroupElement>& Hi,
+        const std::size_t n,
+        const std::size_t m
+    );
     Grootle(
         const GroupElement& H,
         const std::vector<GroupElement>& Gi,
         const std::vector<GroupElement>& Hi,
+        const FixedMultiExponent& Gi_table,
+        const FixedMultiExponent& Hi_table,
         const std::size_t n,
         const std::size_t m
     );
 
+    // With a pool, proving splits its coefficient and multiexponentiation work across the pool's threads,
+    // and batch verification splits its final multiexponentiation into ranges on the pool
     void prove(const std::size_t l,
         const Scalar& s,
         const std::vector<GroupElement>& S,
@@ -27,28 +55,65 @@ public:
         const std::vector<GroupElement>& V,
         const GroupElement& V1,
         const std::vector<unsigned char>& root,
-        GrootleProof& proof);
+        GrootleProof& proof,
+        ThreadPool* thread_pool = nullptr) const;
     bool verify(const std::vector<GroupElement>& S,
         const GroupElement& S1,
         const std::vector<GroupElement>& V,
         const GroupElement& V1,
         const std::vector<unsigned char>& root,
         const std::size_t size,
-        const GrootleProof& proof); // single proof
+        const GrootleProof& proof) const; // single proof
     bool verify(const std::vector<GroupElement>& S,
         const std::vector<GroupElement>& S1,
         const std::vector<GroupElement>& V,
         const std::vector<GroupElement>& V1,
         const std::vector<std::vector<unsigned char>>& roots,
         const std::vector<std::size_t>& sizes,
-        const std::vector<GrootleProof>& proofs); // batch of proofs
+        const std::vector<GrootleProof>& proofs,
+        ThreadPool* thread_pool = nullptr) const; // batch of proofs
+    bool verify(const GroupElement* S,
+        const GroupElement* V,
+        const std::size_t commits_size,
+        const std::vector<GroupElement>& S1,
+        const std::vector<GroupElement>& V1,
+        const std::vector<std::vector<unsigned char>>& roots,
+        const std::vector<std::size_t>& sizes,
+        const std::vector<GrootleProof>& proofs,
+        ThreadPool* thread_pool = nullptr) const; // batch of proofs over a commitment prefix
+    bool verify(const std::vector<GrootleStatement>& statements, ThreadPool* thread_pool = nullptr) const; // batches over distinct commitment sets
 
 private:
-    GroupElement H;
-    std::vector<GroupElement> Gi;
-    std::vector<GroupElement> Hi;
+    static std::size_t batch_size(const std::size_t commits_size, const std::vector<GrootleProof>& proofs);
+    bool accumulate(const GroupElement* S,
+        const GroupElement* V,
+        const std::size_t commits_size,
+        const std::vector<GroupElement>& S1,
+        const std::vector<GroupElement>& V1,
+        const std::vector<std::vector<unsigned char>>& roots,
+        const std::vector<std::size_t>& sizes,
+        const std::vector<GrootleProof>& proofs,
+        Scalar& H_scalar,
+        std::vector<Scalar>& Gi_scalars,
+        std::vector<Scalar>& Hi_scalars,
+        std::vector<GroupElement>& points,
+        std::vector<Scalar>& scalars) const;
+    bool verify_accumulated(const Scalar& H_scalar,
+        const std::vector<Scalar>& Gi_scalars,
+        const std::vector<Scalar>& Hi_scalars,
+        std::vector<GroupElement>& points,
+        std::vector<Scalar>& scalars,
+        ThreadPool* thread_pool) const;
+    GroupElement vector_commit(const std::vector<Scalar>& a, const std::vector<Scalar>& b, const Scalar& r) const;
+
+    const GroupElement& H;
+    const std::vector<GroupElement>& Gi;
+    const std::vector<GroupElement>& Hi;
     std::size_t n;
     std::size_t m;
+    Transcript transcript_prefix; // domain, generators and size parameters, shared by every proof
+    const FixedMultiExponent* Gi_table = nullptr;
+    const FixedMultiExponent* Hi_table = nullptr;
 };
 
 }
@@ -25,6 +25,13 @@ KDF::KDF(const std::string label, std::size_t derived_key_size) {
 	this->derived_key_size = derived_key_size;
 }
 
+// Copy another KDF's state
+KDF::KDF(const KDF& kdf) {
+	this->ctx = EVP_MD_CTX_new();
+	EVP_MD_CTX_copy_ex(this->ctx, kdf.ctx);
+	this->derived_key_size = kdf.derived_key_size;
+}
+
 // Clean up
 KDF::~KDF() {
 	EVP_MD_CTX_free(this->ctx);
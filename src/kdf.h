@@ -8,6 +8,8 @@ namespace spark {
 class KDF {
 public:
 	KDF(const std::string label, std::size_t derived_key_size);
+	KDF(const KDF& kdf); // snapshot of the current state, so a labeled prefix can be reused
+	KDF& operator=(const KDF&) = delete;
 	~KDF();
 	void include(CDataStream& data);
 	std::vector<unsigned char> finalize();
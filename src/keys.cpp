@@ -79,8 +79,8 @@ FullViewKey::FullViewKey(const SpendKey& spend_key) {
 	this->params = spend_key.get_params();
 	this->s1 = spend_key.get_s1();
 	this->s2 = spend_key.get_s2();
-	this->D = this->params->get_G()*spend_key.get_r();
-	this->P2 = this->params->get_F()*this->s2 + this->D;
+	this->D = this->params->mul_G(spend_key.get_r());
+	this->P2 = this->params->mul_F(this->s2) + this->D;
 }
 
 const Params* FullViewKey::get_params() const {
@@ -140,6 +140,39 @@ uint64_t IncomingViewKey::get_diversifier(const std::vector<unsigned char>& d) c
 	return i;
 }
 
+PreparedIncomingViewKey::PreparedIncomingViewKey(const IncomingViewKey& incoming_view_key_, const std::vector<uint64_t>& diversifiers)
+	: incoming_view_key(incoming_view_key_)
+{
+	std::vector<unsigned char> key = SparkUtils::kdf_diversifier(incoming_view_key.get_s1());
+	unsigned char iv[AES_BLOCKSIZE] = {};
+	this->diversifier_aes.reset(new AES256CBCDecrypt(key.data(), iv, true));
+
+	for (uint64_t i : diversifiers) {
+		Address address(incoming_view_key, i);
+		PreparedDiversifier& diversifier = this->prepared[i];
+		diversifier.d = address.get_d();
+		diversifier.div = SparkUtils::hash_div(diversifier.d);
+		diversifier.Q2 = address.get_Q2();
+	}
+}
+
+const IncomingViewKey& PreparedIncomingViewKey::get_incoming_view_key() const {
+	return this->incoming_view_key;
+}
+
+const Scalar& PreparedIncomingViewKey::get_s1() const {
+	return this->incoming_view_key.get_s1();
+}
+
+bool PreparedIncomingViewKey::get_diversifier(const std::vector<unsigned char>& d, uint64_t& i) const {
+	return SparkUtils::diversifier_decrypt(*this->diversifier_aes, d, i);
+}
+
+const PreparedDiversifier* PreparedIncomingViewKey::get_prepared(const uint64_t i) const {
+	auto it = this->prepared.find(i);
+	return it == this->prepared.end() ? nullptr : &it->second;
+}
+
 Address::Address() {}
 
 Address::Address(const Params* params) {
@@ -152,7 +185,7 @@ Address::Address(const IncomingViewKey& incoming_view_key, const uint64_t i) {
 	this->params = incoming_view_key.get_params();
 	this->d = SparkUtils::diversifier_encrypt(key, i);
 	this->Q1 = SparkUtils::hash_div(this->d)*incoming_view_key.get_s1();
-	this->Q2 = this->params->get_F()*SparkUtils::hash_Q2(incoming_view_key.get_s1(), i) + incoming_view_key.get_P2();
+	this->Q2 = this->params->mul_F(SparkUtils::hash_Q2(incoming_view_key.get_s1(), i)) + incoming_view_key.get_P2();
 }
 
 const Params* Address::get_params() const {
@@ -268,7 +301,7 @@ void Address::prove_own(const Scalar& m,
     c.randomize();
 
     GroupElement H = SparkUtils::hash_div(this->d);
-    proof.A = H * a + this->params->get_G() * b + this->params->get_F() * c;
+    proof.A = H * a + this->params->mul_G(b) + this->params->mul_F(c);
 
     if (proof.A.isInfinity()) {
         throw std::invalid_argument("Bad Proof construction!");
@@ -303,7 +336,7 @@ bool Address::verify_own(const Scalar& m,
     Scalar x_sqr = x.square();
 
     GroupElement left = proof.A + this->Q1 * x + this->Q2 * x_sqr;
-    GroupElement right = H * proof.t1 + this->params->get_G() * proof.t2 + this->params->get_F() * proof.t3;
+    GroupElement right = H * proof.t1 + this->params->mul_G(proof.t2) + this->params->mul_F(proof.t3);
 
     return left == right;
 }
@@ -6,6 +6,8 @@
 #include "util.h"
 #include "../bitcoin/uint256.h"
 #include "ownership_proof.h"
+#include <memory>
+#include <unordered_map>
 
 namespace spark {
 
@@ -71,6 +73,34 @@ private:
 	GroupElement P2;
 };
 
+// Values for one of a wallet's diversifiers, used when validating coins sent to that address
+struct PreparedDiversifier {
+	std::vector<unsigned char> d; // encrypted diversifier
+	GroupElement div; // diversified base hash_div(d)
+	GroupElement Q2; // address component of serial commitments
+};
+
+// Incoming view key with precomputation for identifying many coins
+// The diversifier key schedule is derived once, and values for the given diversifiers are cached
+// It is immutable once built, so scanning threads may share it
+class PreparedIncomingViewKey {
+public:
+	explicit PreparedIncomingViewKey(const IncomingViewKey& incoming_view_key, const std::vector<uint64_t>& diversifiers = {});
+	const IncomingViewKey& get_incoming_view_key() const;
+	const Scalar& get_s1() const;
+
+	// Decrypt an encrypted diversifier, returning false if it is malformed
+	bool get_diversifier(const std::vector<unsigned char>& d, uint64_t& i) const;
+
+	// Cached values for a diversifier, or null if it was not prepared
+	const PreparedDiversifier* get_prepared(const uint64_t i) const;
+
+private:
+	IncomingViewKey incoming_view_key;
+	std::unique_ptr<AES256CBCDecrypt> diversifier_aes;
+	std::unordered_map<uint64_t, PreparedDiversifier> prepared;
+};
+
 class Address {
 public:
     Address();
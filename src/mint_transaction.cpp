@@ -16,7 +16,7 @@ MintTransaction::MintTransaction(
 	// Important note: For pool transition transactions, the serial context should contain unique references to all base-layer spent assets, in order to ensure the resulting serial commitment is bound to this transaction
 
 	this->params = params;
-	Schnorr schnorr(this->params->get_H());
+	Schnorr schnorr(this->params->get_H_table());
 
 	std::vector<GroupElement> value_statement;
 	std::vector<Scalar> value_witness;
@@ -39,7 +39,7 @@ MintTransaction::MintTransaction(
             ));
 
             // Prepare the value proof
-            value_statement.emplace_back(this->coins[j].C + this->params->get_G().inverse()*Scalar(this->coins[j].v));
+            value_statement.emplace_back(this->coins[j].C + this->params->mul_G(Scalar(this->coins[j].v)).inverse());
             value_witness.emplace_back(SparkUtils::hash_val(k));
         } else {
             Coin coin(params);
@@ -61,11 +61,11 @@ MintTransaction::MintTransaction(
 
 bool MintTransaction::verify() {
 	// Verify the value proof
-	Schnorr schnorr(this->params->get_H());
+	Schnorr schnorr(this->params->get_H_table());
 	std::vector<GroupElement> value_statement;
 
 	for (std::size_t j = 0; j < this->coins.size(); j++) {
-		value_statement.emplace_back(this->coins[j].C + this->params->get_G().inverse()*Scalar(this->coins[j].v));
+		value_statement.emplace_back(this->coins[j].C + this->params->mul_G(Scalar(this->coins[j].v)).inverse());
 	}
 
 	return schnorr.verify(value_statement, this->value_proof);
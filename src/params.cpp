@@ -1,6 +1,8 @@
 #include "params.h"
 //#include "chainparams.h"
 #include "util.h"
+#include "bpplus.h"
+#include "grootle.h"
 
 namespace spark {
 
@@ -59,6 +61,10 @@ Params::Params(
     this->G.set_base_g();
     this->H = SparkUtils::hash_generator(LABEL_GENERATOR_H);
     this->U = SparkUtils::hash_generator(LABEL_GENERATOR_U);
+    this->F_table.reset(new FixedBaseExponent(this->F));
+    this->G_table.reset(new FixedBaseExponent(this->G));
+    this->H_table.reset(new FixedBaseExponent(this->H));
+    this->U_table.reset(new FixedBaseExponent(this->U));
 
     // Coin parameters
     this->memo_bytes = memo_bytes;
@@ -71,6 +77,8 @@ Params::Params(
         this->G_range[i] = SparkUtils::hash_generator(LABEL_GENERATOR_G_RANGE + " " + std::to_string(i));
         this->H_range[i] = SparkUtils::hash_generator(LABEL_GENERATOR_H_RANGE + " " + std::to_string(i));
     }
+    this->G_range_table.reset(new FixedMultiExponent(this->G_range));
+    this->H_range_table.reset(new FixedMultiExponent(this->H_range));
 
     // One-of-many parameters
     if (n_grootle < 2 || m_grootle < 3) {
@@ -84,7 +92,30 @@ Params::Params(
         this->G_grootle[i] = SparkUtils::hash_generator(LABEL_GENERATOR_G_GROOTLE + " " + std::to_string(i));
         this->H_grootle[i] = SparkUtils::hash_generator(LABEL_GENERATOR_H_GROOTLE + " " + std::to_string(i));
     }
-}
+    this->G_grootle_table.reset(new FixedMultiExponent(this->G_grootle));
+    this->H_grootle_table.reset(new FixedMultiExponent(this->H_grootle));
+
+    this->range.reset(new BPPlus(
+        *this->G_table,
+        *this->H_table,
+        this->G_range,
+        this->H_range,
+        *this->G_range_table,
+        *this->H_range_table,
+        64
+    ));
+    this->grootle.reset(new Grootle(
+        this->H,
+        this->G_grootle,
+        this->H_grootle,
+        *this->G_grootle_table,
+        *this->H_grootle_table,
+        this->n_grootle,
+        this->m_grootle
+    ));
+}
+
+Params::~Params() = default;
 
 const GroupElement& Params::get_F() const {
     return this->F;
@@ -102,6 +133,38 @@ const GroupElement& Params::get_U() const {
     return this->U;
 }
 
+GroupElement Params::mul_F(const Scalar& s) const {
+    return this->F_table->get_multiple(s);
+}
+
+GroupElement Params::mul_G(const Scalar& s) const {
+    return this->G_table->get_multiple(s);
+}
+
+GroupElement Params::mul_H(const Scalar& s) const {
+    return this->H_table->get_multiple(s);
+}
+
+GroupElement Params::mul_U(const Scalar& s) const {
+    return this->U_table->get_multiple(s);
+}
+
+const FixedBaseExponent& Params::get_F_table() const {
+    return *this->F_table;
+}
+
+const FixedBaseExponent& Params::get_G_table() const {
+    return *this->G_table;
+}
+
+const FixedBaseExponent& Params::get_H_table() const {
+    return *this->H_table;
+}
+
+const FixedBaseExponent& Params::get_U_table() const {
+    return *this->U_table;
+}
+
 const std::size_t Params::get_memo_bytes() const {
     return this->memo_bytes;
 }
@@ -114,6 +177,14 @@ const std::vector<GroupElement>& Params::get_H_range() const {
     return this->H_range;
 }
 
+const FixedMultiExponent& Params::get_G_range_table() const {
+    return *this->G_range_table;
+}
+
+const FixedMultiExponent& Params::get_H_range_table() const {
+    return *this->H_range_table;
+}
+
 const std::vector<GroupElement>& Params::get_G_grootle() const {
     return this->G_grootle;
 }
@@ -122,6 +193,22 @@ const std::vector<GroupElement>& Params::get_H_grootle() const {
     return this->H_grootle;
 }
 
+const FixedMultiExponent& Params::get_G_grootle_table() const {
+    return *this->G_grootle_table;
+}
+
+const FixedMultiExponent& Params::get_H_grootle_table() const {
+    return *this->H_grootle_table;
+}
+
+const BPPlus& Params::get_range() const {
+    return *this->range;
+}
+
+const Grootle& Params::get_grootle() const {
+    return *this->grootle;
+}
+
 std::size_t Params::get_max_M_range() const {
     return this->max_M_range;
 }
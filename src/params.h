@@ -3,6 +3,8 @@
 
 #include "../secp256k1/include/Scalar.h"
 #include "../secp256k1/include/GroupElement.h"
+#include "../secp256k1/include/FixedBaseExponent.h"
+#include "../secp256k1/include/FixedMultiExponent.h"
 #include "../bitcoin/serialize.h"
 #include "../bitcoin/sync.h"
 
@@ -10,26 +12,49 @@ using namespace secp_primitives;
 
 namespace spark {
 
+class BPPlus;
+class Grootle;
+
 class Params {
 public:
     static Params const* get_default();
     static Params const* get_test();
+    ~Params();
 
     const GroupElement& get_F() const;
     const GroupElement& get_G() const;
     const GroupElement& get_H() const;
     const GroupElement& get_U() const;
 
+    // Multiplication of the global generators using precomputed tables
+    GroupElement mul_F(const Scalar& s) const;
+    GroupElement mul_G(const Scalar& s) const;
+    GroupElement mul_H(const Scalar& s) const;
+    GroupElement mul_U(const Scalar& s) const;
+
+    const FixedBaseExponent& get_F_table() const;
+    const FixedBaseExponent& get_G_table() const;
+    const FixedBaseExponent& get_H_table() const;
+    const FixedBaseExponent& get_U_table() const;
+
     const std::size_t get_memo_bytes() const;
 
     std::size_t get_max_M_range() const;
     const std::vector<GroupElement>& get_G_range() const;
     const std::vector<GroupElement>& get_H_range() const;
+    const FixedMultiExponent& get_G_range_table() const;
+    const FixedMultiExponent& get_H_range_table() const;
 
     std::size_t get_n_grootle() const;
     std::size_t get_m_grootle() const;
     const std::vector<GroupElement>& get_G_grootle() const;
     const std::vector<GroupElement>& get_H_grootle() const;
+    const FixedMultiExponent& get_G_grootle_table() const;
+    const FixedMultiExponent& get_H_grootle_table() const;
+
+    // Provers and verifiers over the generators above; copy one to set per-call options
+    const BPPlus& get_range() const;
+    const Grootle& get_grootle() const;
 
 private:
     Params(
@@ -48,6 +73,7 @@ private:
     GroupElement G;
     GroupElement H;
     GroupElement U;
+    std::unique_ptr<FixedBaseExponent> F_table, G_table, H_table, U_table;
 
     // Coin parameters
     std::size_t memo_bytes;
@@ -55,11 +81,17 @@ private:
     // Range proof parameters
     std::size_t max_M_range;
     std::vector<GroupElement> G_range, H_range;
+    std::unique_ptr<FixedMultiExponent> G_range_table, H_range_table;
 
     // One-of-many parameters
     std::size_t n_grootle, m_grootle;
     std::vector<GroupElement> G_grootle;
     std::vector<GroupElement> H_grootle;
+    std::unique_ptr<FixedMultiExponent> G_grootle_table, H_grootle_table;
+
+    // Built once, so their transcript prefixes are hashed only here
+    std::unique_ptr<BPPlus> range;
+    std::unique_ptr<Grootle> grootle;
 };
 
 }
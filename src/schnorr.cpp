@@ -4,7 +4,15 @@
 namespace spark {
 
 Schnorr::Schnorr(const GroupElement& G_):
-    G(G_) {
+    G(G_), G_table(nullptr) {
+}
+
+Schnorr::Schnorr(const FixedBaseExponent& G_table_):
+    G(G_table_.get_base()), G_table(&G_table_) {
+}
+
+GroupElement Schnorr::mul_G(const Scalar& s) const {
+    return G_table ? G_table->get_multiple(s) : G*s;
 }
 
 Scalar Schnorr::challenge(
@@ -33,14 +41,14 @@ void Schnorr::prove(const std::vector<Scalar>& y, const std::vector<GroupElement
     }
 
     for (std::size_t i = 0; i < n; i++) {
-        if (G*y[i] != Y[i]) {
+        if (mul_G(y[i]) != Y[i]) {
             throw std::invalid_argument("Bad Schnorr statement!");
         }
     }
 
     Scalar r;
     r.randomize();
-    proof.A = G*r;
+    proof.A = mul_G(r);
 
     const Scalar c = challenge(Y, proof.A);
     Scalar c_power(c);
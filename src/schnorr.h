@@ -3,12 +3,14 @@
 
 #include "schnorr_proof.h"
 #include "../secp256k1/include/MultiExponent.h"
+#include "../secp256k1/include/FixedBaseExponent.h"
 
 namespace spark {
 
 class Schnorr {
 public:
     Schnorr(const GroupElement& G);
+    Schnorr(const FixedBaseExponent& G_table);
 
     void prove(const Scalar& y, const GroupElement& Y, SchnorrProof& proof);
     void prove(const std::vector<Scalar>& y, const std::vector<GroupElement>& Y, SchnorrProof& proof);
@@ -17,7 +19,9 @@ public:
 
 private:
     Scalar challenge(const std::vector<GroupElement>& Y, const GroupElement& A);
+    GroupElement mul_G(const Scalar& s) const;
     const GroupElement& G;
+    const FixedBaseExponent* G_table;
 };
 
 }
@@ -1,10 +1,36 @@
 #include "../include/spark.h"
 #include "spark.h"
+#include "coin_scan_view.h"
 //#include "../bitcoin/amount.h"
 //#include <iostream>
 
 #define SPARK_VALUE_SPEND_LIMIT_PER_TRANSACTION     (10000 * COIN)
 
+// Workers for spend proving; the calling thread works alongside them
+static std::mutex proverThreadPoolMutex;
+static std::size_t proverThreads = 0;
+static std::shared_ptr<spark::ThreadPool> proverThreadPool;
+
+void setSparkProverThreads(std::size_t threads) {
+    std::lock_guard<std::mutex> lock(proverThreadPoolMutex);
+    proverThreads = threads;
+    proverThreadPool.reset(); // spends already proving keep their pool alive until they finish
+}
+
+// Returns the pool for the configured thread count, or nothing when proving on the calling thread alone
+static std::shared_ptr<spark::ThreadPool> getProverThreadPool() {
+    std::lock_guard<std::mutex> lock(proverThreadPoolMutex);
+    const std::size_t threads = proverThreads ? proverThreads : std::max(1u, std::thread::hardware_concurrency());
+    if (threads <= 1) {
+        return nullptr;
+    }
+    if (!proverThreadPool) {
+        proverThreadPool = std::make_shared<spark::ThreadPool>(threads - 1);
+    }
+
+    return proverThreadPool;
+}
+
 
 spark::SpendKey createSpendKey(const SpendKeyData& data) {
     std::string nCountStr = std::to_string(data.getIndex());
@@ -336,6 +362,8 @@ void createSparkSpendTransaction(
     uint256 sig = txHashSig;
 
     std::vector<spark::InputCoinData> inputs;
+    std::vector<spark::Coin> inputCoins;
+    std::vector<spark::IdentifiedCoinData> identifiedCoins;
     std::map<uint64_t, uint256> idAndBlockHashes;
     std::unordered_map<uint64_t, spark::CoverSetData> cover_set_data;
     for (auto& coin : estimated.second) {
@@ -364,14 +392,21 @@ void createSparkSpendTransaction(
         identifiedCoinData.v = coin.v;
         identifiedCoinData.k = coin.k;
         identifiedCoinData.memo = coin.memo;
-        spark::RecoveredCoinData recoveredCoinData = coin.coin.recover(fullViewKey, identifiedCoinData);
 
-        inputCoinData.T = recoveredCoinData.T;
-        inputCoinData.s = recoveredCoinData.s;
+        inputCoins.push_back(coin.coin);
+        identifiedCoins.push_back(identifiedCoinData);
         inputs.push_back(inputCoinData);
     }
 
-    spark::SpendTransaction spendTransaction(params, fullViewKey, spendKey, inputs, cover_set_data, fee, transparentOut, privOutputs);
+    // Recover all serials and tags together
+    std::vector<spark::RecoveredCoinData> recoveredCoins = spark::Coin::recover(fullViewKey, inputCoins, identifiedCoins);
+    for (size_t i = 0; i < inputs.size(); i++) {
+        inputs[i].T = recoveredCoins[i].T;
+        inputs[i].s = recoveredCoins[i].s;
+    }
+
+    std::shared_ptr<spark::ThreadPool> pool = getProverThreadPool();
+    spark::SpendTransaction spendTransaction(params, fullViewKey, spendKey, inputs, cover_set_data, fee, transparentOut, privOutputs, pool.get());
     spendTransaction.setBlockHashes(idAndBlockHashes);
     CDataStream serialized(SER_NETWORK, PROTOCOL_VERSION);
     serialized << spendTransaction;
@@ -422,7 +457,8 @@ void getSparkSpendScripts(const spark::FullViewKey& fullViewKey,
     inputScript.clear();
     outputScripts.clear();
     const auto* params = spark::Params::get_default();
-    spark::SpendTransaction spendTransaction(params, fullViewKey, spendKey, inputs, cover_set_data, fee, transparentOut, privOutputs);
+    std::shared_ptr<spark::ThreadPool> pool = getProverThreadPool();
+    spark::SpendTransaction spendTransaction(params, fullViewKey, spendKey, inputs, cover_set_data, fee, transparentOut, privOutputs, pool.get());
     spendTransaction.setBlockHashes(idAndBlockHashes);
     CDataStream serialized(SER_NETWORK, PROTOCOL_VERSION);
     serialized << spendTransaction;
@@ -491,15 +527,8 @@ void ParseSparkMintCoin(const CScript& script, spark::Coin& txCoin)
     }
 }
 
-CSparkMintMeta getMetadata(const spark::Coin& coin, const spark::IncomingViewKey& incoming_view_key) {
+static CSparkMintMeta buildMetadata(const spark::Coin& coin, const spark::IdentifiedCoinData& identifiedCoinData) {
     CSparkMintMeta meta;
-    spark::IdentifiedCoinData identifiedCoinData;
-    try {
-        identifiedCoinData = identifyCoin(coin, incoming_view_key);
-    } catch (...) {
-        return meta;
-    }
-
     meta.isUsed = false;
     meta.v = identifiedCoinData.v;
     meta.memo = identifiedCoinData.memo;
@@ -512,21 +541,103 @@ CSparkMintMeta getMetadata(const spark::Coin& coin, const spark::IncomingViewKey
     return meta;
 }
 
+CSparkMintMeta getMetadata(const spark::Coin& coin, const spark::IncomingViewKey& incoming_view_key) {
+    std::optional<spark::IdentifiedCoinData> identifiedCoinData = coin.try_identify(incoming_view_key);
+    if (!identifiedCoinData) {
+        return CSparkMintMeta();
+    }
+
+    return buildMetadata(coin, *identifiedCoinData);
+}
+
+std::vector<CSparkMintMeta> identifyCoins(const std::vector<spark::Coin>& coins, const spark::IncomingViewKey& incoming_view_key, std::size_t threads) {
+    return identifyCoins(coins, spark::PreparedIncomingViewKey(incoming_view_key), threads);
+}
+
+// Scan n coins across threads (0 for one per core) in fixed chunks, each reusing one set of decryption state
+// scanChunk(decryptor, begin, end, matches) appends metadata for the matching coins in [begin, end) in order
+template <typename ScanChunk>
+static std::vector<CSparkMintMeta> scanCoins(const std::size_t n, std::size_t threads, ScanChunk scanChunk) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const std::size_t chunk_size = 256;
+    const std::size_t chunks = (n + chunk_size - 1) / chunk_size;
+    std::vector<std::vector<CSparkMintMeta>> matches(chunks);
+
+    spark::ThreadPool pool(std::min(threads, std::max<std::size_t>(chunks, 1)) - 1);
+    pool.parallel_for(chunks, [&](std::size_t chunk) {
+        spark::AEADDecryptor decryptor;
+        const std::size_t begin = chunk*chunk_size;
+        scanChunk(decryptor, begin, std::min(n, begin + chunk_size), matches[chunk]);
+    });
+
+    std::vector<CSparkMintMeta> result;
+    for (std::vector<CSparkMintMeta>& chunk_matches : matches) {
+        std::move(chunk_matches.begin(), chunk_matches.end(), std::back_inserter(result));
+    }
+
+    return result;
+}
+
+std::vector<CSparkMintMeta> identifyCoins(const std::vector<spark::Coin>& coins, const spark::PreparedIncomingViewKey& incoming_view_key, std::size_t threads) {
+    return scanCoins(coins.size(), threads, [&](spark::AEADDecryptor& decryptor, std::size_t begin, std::size_t end, std::vector<CSparkMintMeta>& matches) {
+        // Coins that decrypt are validated together
+        std::vector<std::optional<spark::IdentifiedCoinData>> identifiedCoinData = spark::Coin::try_identify(incoming_view_key, coins.data() + begin, end - begin, decryptor);
+        for (std::size_t j = begin; j < end; j++) {
+            if (identifiedCoinData[j - begin]) {
+                matches.emplace_back(buildMetadata(coins[j], *identifiedCoinData[j - begin]));
+            }
+        }
+    });
+}
+
+std::vector<CSparkMintMeta> identifyCoins(
+        const std::vector<std::vector<unsigned char>>& serialized_coins,
+        const std::vector<std::vector<unsigned char>>& serial_contexts,
+        const spark::PreparedIncomingViewKey& incoming_view_key,
+        std::size_t threads) {
+    if (serialized_coins.size() != serial_contexts.size()) {
+        throw std::invalid_argument("Serialized coins and serial contexts do not match");
+    }
+
+    return scanCoins(serialized_coins.size(), threads, [&](spark::AEADDecryptor& decryptor, std::size_t begin, std::size_t end, std::vector<CSparkMintMeta>& matches) {
+        for (std::size_t j = begin; j < end; j++) {
+            // Only coins whose key commitment matches are fully decoded
+            const std::vector<unsigned char>& serialized = serialized_coins[j];
+            std::optional<spark::CoinScanView> view;
+            try {
+                view.emplace(serialized.data(), serialized.size());
+            } catch (const std::invalid_argument&) {
+                continue;
+            }
+            if (view->get_encoded_size() != serialized.size()) {
+                continue;
+            }
+
+            spark::Coin coin;
+            std::optional<spark::IdentifiedCoinData> identifiedCoinData = view->try_identify(incoming_view_key, decryptor, serial_contexts[j], coin);
+            if (identifiedCoinData) {
+                matches.emplace_back(buildMetadata(coin, *identifiedCoinData));
+            }
+        }
+    });
+}
+
 spark::InputCoinData getInputData(spark::Coin coin, const spark::FullViewKey& full_view_key, const spark::IncomingViewKey& incoming_view_key)
 {
     spark::InputCoinData inputCoinData;
-    spark::IdentifiedCoinData identifiedCoinData;
-    try {
-        identifiedCoinData = identifyCoin(coin, incoming_view_key);
-    } catch (...) {
+    std::optional<spark::IdentifiedCoinData> identifiedCoinData = coin.try_identify(incoming_view_key);
+    if (!identifiedCoinData) {
         return inputCoinData;
     }
 
-    spark::RecoveredCoinData recoveredCoinData = coin.recover(full_view_key, identifiedCoinData);
+    spark::RecoveredCoinData recoveredCoinData = coin.recover(full_view_key, *identifiedCoinData);
     inputCoinData.T = recoveredCoinData.T;
     inputCoinData.s = recoveredCoinData.s;
-    inputCoinData.k = identifiedCoinData.k;
-    inputCoinData.v = identifiedCoinData.v;
+    inputCoinData.k = identifiedCoinData->k;
+    inputCoinData.v = identifiedCoinData->v;
 
     return inputCoinData;
 }
@@ -16,7 +16,8 @@ SpendTransaction::SpendTransaction(
     const std::unordered_map<uint64_t, CoverSetData>& cover_set_data,
 	const uint64_t f,
     const uint64_t vout,
-	const std::vector<OutputCoinData>& outputs
+	const std::vector<OutputCoinData>& outputs,
+	ThreadPool* thread_pool
 ) {
 	this->params = params;
 
@@ -30,7 +31,6 @@ SpendTransaction::SpendTransaction(
     this->setCoverSets(cover_set_data);
 	this->S1.reserve(w); // serial commitment offsets
 	this->C1.reserve(w); // value commitment offsets
-	this->grootle_proofs.reserve(w); // Grootle one-of-many proofs
 	this->T.reserve(w); // linking tags
 
 	this->f = f; // fee
@@ -44,13 +44,10 @@ SpendTransaction::SpendTransaction(
 	std::vector<Scalar> k; // nonces
 
 	// Prepare inputs
-	Grootle grootle(
-		this->params->get_H(),
-		this->params->get_G_grootle(),
-		this->params->get_H_grootle(),
-		this->params->get_n_grootle(),
-		this->params->get_m_grootle()
-	);
+	const Grootle& grootle = this->params->get_grootle();
+	std::unordered_map<uint64_t, CoverSetPoints> input_cover_set_points;
+	std::vector<const CoverSetPoints*> input_points;
+	std::vector<const std::vector<unsigned char>*> input_roots;
 	for (std::size_t u = 0; u < w; u++) {
 		// Parse out cover set data for this spend
         uint64_t set_id = inputs[u].cover_set_id;
@@ -63,44 +60,36 @@ SpendTransaction::SpendTransaction(
         if (set_size > N)
             throw std::invalid_argument("Wrong set size");
 
-        std::vector<GroupElement> S, C;
-		S.reserve(set_size);
-		C.reserve(set_size);
-		for (std::size_t i = 0; i < set_size; i++) {
-			S.emplace_back(cover_set[i].S);
-			C.emplace_back(cover_set[i].C);
-		}
+        // Inputs spending from the same set share its commitment vectors
+        CoverSetPoints& points = input_cover_set_points[set_id];
+        if (points.S.empty()) {
+            points.S.reserve(set_size);
+            points.C.reserve(set_size);
+            for (std::size_t i = 0; i < set_size; i++) {
+                points.S.emplace_back(cover_set[i].S);
+                points.C.emplace_back(cover_set[i].C);
+            }
+        }
 
 		// Serial commitment offset
 		this->S1.emplace_back(
-			this->params->get_F()*inputs[u].s
-			+ this->params->get_H().inverse()*SparkUtils::hash_ser1(inputs[u].s, full_view_key.get_D())
+			this->params->mul_F(inputs[u].s)
+			+ this->params->mul_H(SparkUtils::hash_ser1(inputs[u].s, full_view_key.get_D())).inverse()
 			+ full_view_key.get_D()
 		);
 
 		// Value commitment offset
 		this->C1.emplace_back(
-			this->params->get_G()*Scalar(inputs[u].v)
-			+ this->params->get_H()*SparkUtils::hash_val1(inputs[u].s, full_view_key.get_D())
+			this->params->mul_G(Scalar(inputs[u].v))
+			+ this->params->mul_H(SparkUtils::hash_val1(inputs[u].s, full_view_key.get_D()))
 		);
 
 		// Tags
 		this->T.emplace_back(inputs[u].T);
 
-		// Grootle proof
-		this->grootle_proofs.emplace_back();
-		std::size_t l = inputs[u].index;
-		grootle.prove(
-			l,
-			SparkUtils::hash_ser1(inputs[u].s, full_view_key.get_D()),
-			S,
-			this->S1.back(),
-			SparkUtils::hash_val(inputs[u].k) - SparkUtils::hash_val1(inputs[u].s, full_view_key.get_D()),
-			C,
-			this->C1.back(),
-			this->cover_set_representations[set_id],
-			this->grootle_proofs.back()
-		);
+		// Grootle proof statement, proven below
+		input_points.emplace_back(&points);
+		input_roots.emplace_back(&this->cover_set_representations[set_id]);
 
 		// Chaum data
 		chaum_x.emplace_back(inputs[u].s);
@@ -108,6 +97,30 @@ SpendTransaction::SpendTransaction(
 		chaum_z.emplace_back(SparkUtils::hash_ser1(inputs[u].s, full_view_key.get_D()).negate());
 	}
 
+	// Grootle proofs, proven concurrently when a pool is available
+	this->grootle_proofs.resize(w);
+	auto prove_input = [&](std::size_t u) {
+		grootle.prove(
+			inputs[u].index,
+			SparkUtils::hash_ser1(inputs[u].s, full_view_key.get_D()),
+			input_points[u]->S,
+			this->S1[u],
+			SparkUtils::hash_val(inputs[u].k) - SparkUtils::hash_val1(inputs[u].s, full_view_key.get_D()),
+			input_points[u]->C,
+			this->C1[u],
+			*input_roots[u],
+			this->grootle_proofs[u],
+			thread_pool
+		);
+	};
+	if (thread_pool) {
+		thread_pool->parallel_for(w, prove_input);
+	} else {
+		for (std::size_t u = 0; u < w; u++) {
+			prove_input(u);
+		}
+	}
+
 	// Generate output coins and prepare range proof vectors
 	std::vector<Scalar> range_v;
 	std::vector<Scalar> range_r;
@@ -141,13 +154,7 @@ SpendTransaction::SpendTransaction(
 	}
 
 	// Generate range proof
-	BPPlus range(
-		this->params->get_G(),
-		this->params->get_H(),
-		this->params->get_G_range(),
-		this->params->get_H_range(),
-		64
-	);
+	BPPlus range(this->params->get_range());
 	range.prove(
 		range_v,
 		range_r,
@@ -156,7 +163,7 @@ SpendTransaction::SpendTransaction(
 	);
 
 	// Generate the balance proof
-	Schnorr schnorr(this->params->get_H());
+	Schnorr schnorr(this->params->get_H_table());
 	GroupElement balance_statement;
 	Scalar balance_witness;
 	for (std::size_t u = 0; u < w; u++) {
@@ -167,7 +174,7 @@ SpendTransaction::SpendTransaction(
 		balance_statement += this->out_coins[j].C.inverse();
 		balance_witness -= SparkUtils::hash_val(k[j]);
 	}
-	balance_statement += (this->params->get_G()*Scalar(f + vout)).inverse();
+	balance_statement += this->params->mul_G(Scalar(f + vout)).inverse();
 	schnorr.prove(
 		balance_witness,
 		balance_statement,
@@ -191,9 +198,9 @@ SpendTransaction::SpendTransaction(
 
 	// Compute the authorizing Chaum proof
 	Chaum chaum(
-		this->params->get_F(),
-		this->params->get_G(),
-		this->params->get_H(),
+		this->params->get_F_table(),
+		this->params->get_G_table(),
+		this->params->get_H_table(),
 		this->params->get_U()
 	);
 	chaum.prove(
@@ -238,6 +245,26 @@ bool SpendTransaction::verify(
         const Params* params,
         const std::vector<SpendTransaction>& transactions,
         const std::unordered_map<uint64_t, std::vector<Coin>>& cover_sets) {
+	return verify(params, transactions, cover_sets, nullptr, nullptr);
+}
+
+// As above, but taking preprocessed cover set points from a cache that persists across calls
+// With a pool, the range and Grootle batches are verified on its threads
+bool SpendTransaction::verify(
+        const Params* params,
+        const std::vector<SpendTransaction>& transactions,
+        const std::unordered_map<uint64_t, std::vector<Coin>>& cover_sets,
+        CoverSetCache& cover_set_cache,
+        ThreadPool* thread_pool) {
+	return verify(params, transactions, cover_sets, &cover_set_cache, thread_pool);
+}
+
+bool SpendTransaction::verify(
+        const Params* params,
+        const std::vector<SpendTransaction>& transactions,
+        const std::unordered_map<uint64_t, std::vector<Coin>>& cover_sets,
+        CoverSetCache* cover_set_cache,
+        ThreadPool* thread_pool) {
 	// The idea here is to perform batching as broadly as possible
 	// - Grootle proofs can be batched if they share a (partial) cover set
 	// - Range proofs can always be batched arbitrarily
@@ -320,7 +347,7 @@ bool SpendTransaction::verify(
 		}
 
 		// Verify the balance proof
-		Schnorr schnorr(tx.params->get_H());
+		Schnorr schnorr(tx.params->get_H_table());
 		GroupElement balance_statement;
 		for (std::size_t u = 0; u < w; u++) {
 			balance_statement += tx.C1[u];
@@ -328,7 +355,7 @@ bool SpendTransaction::verify(
 		for (std::size_t j = 0; j < t; j++) {
 			balance_statement += tx.out_coins[j].C.inverse();
 		}
-        balance_statement += (tx.params->get_G()*Scalar(tx.f + tx.vout)).inverse();
+        balance_statement += tx.params->mul_G(Scalar(tx.f + tx.vout)).inverse();
         
 		if(!schnorr.verify(
 			balance_statement,
@@ -339,46 +366,50 @@ bool SpendTransaction::verify(
 	}
 
 	// Verify all range proofs in a batch
-	BPPlus range(
-		params->get_G(),
-		params->get_H(),
-		params->get_G_range(),
-		params->get_H_range(),
-		64
-	);
-	if (!range.verify(range_proofs_C, range_proofs)) {
+	const BPPlus& range = params->get_range();
+	if (!range.verify(range_proofs_C, range_proofs, thread_pool)) {
 		return false;
 	}
 
-	// Verify all Grootle proofs in batches (based on cover set)
-	// TODO: Finish this
-	Grootle grootle(
-		params->get_H(),
-		params->get_G_grootle(),
-		params->get_H_grootle(),
-		params->get_n_grootle(),
-		params->get_m_grootle()
-	);
-	for (auto grootle_bucket : grootle_buckets) {
-		std::size_t cover_set_id = grootle_bucket.first;
-		std::vector<std::pair<std::size_t, std::size_t>> proof_indexes = grootle_bucket.second;
+	// Verify all Grootle proofs in batches (based on cover set), resolved together in a single multiscalar multiplication
+	const Grootle& grootle = params->get_grootle();
+	std::vector<GrootleStatement> statements;
+	std::vector<std::shared_ptr<const CoverSetPoints>> statement_points; // keeps cached points alive until verification
+	statements.reserve(grootle_buckets.size());
+	statement_points.reserve(grootle_buckets.size());
+	for (const auto& grootle_bucket : grootle_buckets) {
+		uint64_t cover_set_id = grootle_bucket.first;
+		const std::vector<std::pair<std::size_t, std::size_t>>& proof_indexes = grootle_bucket.second;
+
+        if (!cover_sets.count(cover_set_id))
+            throw std::invalid_argument("Cover set missing");
+
+        // The set's S and C points come preprocessed from the cache if there is one; only the first `full_cover_set_size` apply
+        // Without a cache they are only used for this call, so they are copied out of the coins as they are
+        const std::vector<Coin>& cover_set = cover_sets.at(cover_set_id);
+        std::size_t full_cover_set_size = cover_set.size();
+        if (cover_set_cache) {
+            statement_points.emplace_back(cover_set_cache->get(cover_set_id, cover_set));
+        } else {
+            std::shared_ptr<CoverSetPoints> points = std::make_shared<CoverSetPoints>();
+            points->S.reserve(full_cover_set_size);
+            points->C.reserve(full_cover_set_size);
+            for (const Coin& coin : cover_set) {
+                points->S.emplace_back(coin.S);
+                points->C.emplace_back(coin.C);
+            }
+            statement_points.emplace_back(std::move(points));
+        }
 
 		// Build the proof statement and metadata vectors from these proofs
-		std::vector<GroupElement> S, S1, V, V1;
-		std::vector<std::vector<unsigned char>> cover_set_representations;
-		std::vector<std::size_t> sizes;
-		std::vector<GrootleProof> proofs;
-
-        std::size_t full_cover_set_size = cover_sets.at(cover_set_id).size();
-        for (std::size_t i = 0; i < full_cover_set_size; i++) {
-            S.emplace_back(cover_sets.at(cover_set_id)[i].S);
-            V.emplace_back(cover_sets.at(cover_set_id)[i].C);
-        }
+		statements.emplace_back();
+		GrootleStatement& statement = statements.back();
+		statement.S = statement_points.back()->S.data();
+		statement.V = statement_points.back()->C.data();
+		statement.commits_size = full_cover_set_size;
 
-		for (auto proof_index : proof_indexes) {
+		for (const auto& proof_index : proof_indexes) {
             const auto& tx = transactions[proof_index.first];
-            if (!cover_sets.count(cover_set_id))
-                throw std::invalid_argument("Cover set missing");
 			// Because we assume all proofs in this list share a monotonic cover set, the largest such set is the one to use for verification
             if (!tx.cover_set_sizes.count(cover_set_id))
                 throw std::invalid_argument("Cover set size missing");
@@ -386,20 +417,20 @@ bool SpendTransaction::verify(
 			std::size_t this_cover_set_size = tx.cover_set_sizes.at(cover_set_id);
 
 			// We always use the other elements
-			S1.emplace_back(tx.S1[proof_index.second]);
-			V1.emplace_back(tx.C1[proof_index.second]);
+			statement.S1.emplace_back(tx.S1[proof_index.second]);
+			statement.V1.emplace_back(tx.C1[proof_index.second]);
             if (!tx.cover_set_representations.count(cover_set_id))
                 throw std::invalid_argument("Cover set representation missing");
 
-			cover_set_representations.emplace_back(tx.cover_set_representations.at(cover_set_id));
-			sizes.emplace_back(this_cover_set_size);
-			proofs.emplace_back(tx.grootle_proofs[proof_index.second]);
+			statement.roots.emplace_back(tx.cover_set_representations.at(cover_set_id));
+			statement.sizes.emplace_back(this_cover_set_size);
+			statement.proofs.emplace_back(tx.grootle_proofs[proof_index.second]);
 		}
+	}
 
-		// Verify the batch
-		if (!grootle.verify(S, S1, V, V1, cover_set_representations, sizes, proofs)) {
-            return false;
-        }
+	// Verify all batches at once
+	if (!statements.empty() && !grootle.verify(statements, thread_pool)) {
+		return false;
 	}
 
 	// Any failures have been identified already, so the batch is valid
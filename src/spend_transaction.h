@@ -7,6 +7,7 @@
 #include "grootle.h"
 #include "bpplus.h"
 #include "chaum.h"
+#include "cover_set_cache.h"
 
 namespace spark {
 
@@ -49,7 +50,8 @@ public:
         const std::unordered_map<uint64_t, CoverSetData>& cover_set_data,
 		const uint64_t f,
         const uint64_t vout,
-		const std::vector<OutputCoinData>& outputs
+		const std::vector<OutputCoinData>& outputs,
+		ThreadPool* thread_pool = nullptr // proves inputs concurrently if set
 	);
 
 	uint64_t getFee();
@@ -58,6 +60,7 @@ public:
     const std::vector<uint64_t>& getCoinGroupIds();
 
 	static bool verify(const Params* params, const std::vector<SpendTransaction>& transactions, const std::unordered_map<uint64_t, std::vector<Coin>>& cover_sets);
+	static bool verify(const Params* params, const std::vector<SpendTransaction>& transactions, const std::unordered_map<uint64_t, std::vector<Coin>>& cover_sets, CoverSetCache& cover_set_cache, ThreadPool* thread_pool = nullptr);
 	static bool verify(const SpendTransaction& transaction, const std::unordered_map<uint64_t, std::vector<Coin>>& cover_sets);
     
 	static std::vector<unsigned char> hash_bind_inner(
@@ -110,6 +113,8 @@ public:
 
     const std::map<uint64_t, uint256>& getBlockHashes();
 private:
+	static bool verify(const Params* params, const std::vector<SpendTransaction>& transactions, const std::unordered_map<uint64_t, std::vector<Coin>>& cover_sets, CoverSetCache* cover_set_cache, ThreadPool* thread_pool);
+
 	const Params* params;
     // We need to construct and pass this data before running verification
 	std::unordered_map<uint64_t, std::size_t> cover_set_sizes;
@@ -0,0 +1,119 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace spark {
+
+ThreadPool::ThreadPool(std::size_t n_threads) {
+    workers.reserve(n_threads);
+    for (std::size_t i = 0; i < n_threads; i++) {
+        workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+std::size_t ThreadPool::size() const {
+    return workers.size();
+}
+
+void ThreadPool::work() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+// Shared state of a single loop; helpers that start after every index is taken simply exit
+struct ParallelLoop {
+    std::size_t n;
+    std::function<void(std::size_t)> f;
+    std::atomic<std::size_t> next{0};
+    std::size_t done = 0;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable finished;
+
+    void run() {
+        std::size_t completed = 0;
+        std::exception_ptr first_error;
+        for (std::size_t i = next++; i < n; i = next++) {
+            try {
+                f(i);
+            } catch (...) {
+                if (!first_error) {
+                    first_error = std::current_exception();
+                }
+            }
+            completed++;
+        }
+        if (completed == 0) {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (first_error && !error) {
+            error = first_error;
+        }
+        done += completed;
+        if (done == n) {
+            finished.notify_all();
+        }
+    }
+};
+
+void ThreadPool::parallel_for(std::size_t n, const std::function<void(std::size_t)>& f) {
+    if (n == 0) {
+        return;
+    }
+    if (n == 1 || workers.empty()) {
+        for (std::size_t i = 0; i < n; i++) {
+            f(i);
+        }
+        return;
+    }
+
+    std::shared_ptr<ParallelLoop> loop = std::make_shared<ParallelLoop>();
+    loop->n = n;
+    loop->f = f;
+
+    const std::size_t helpers = std::min(n - 1, workers.size());
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (std::size_t i = 0; i < helpers; i++) {
+            tasks.emplace_back([loop] { loop->run(); });
+        }
+    }
+    condition.notify_all();
+
+    // Work on the loop here too, then wait for indexes still running elsewhere
+    loop->run();
+    std::unique_lock<std::mutex> lock(loop->mutex);
+    loop->finished.wait(lock, [&loop] { return loop->done == loop->n; });
+    if (loop->error) {
+        std::rethrow_exception(loop->error);
+    }
+}
+
+}
@@ -0,0 +1,43 @@
+#ifndef FIRO_SPARK_THREAD_POOL_H
+#define FIRO_SPARK_THREAD_POOL_H
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace spark {
+
+// Fixed set of worker threads used to split proving work
+// The calling thread always takes part in its own loops, so loops may be nested
+// (for example, proofs run in parallel that each split their own work) without deadlock
+class ThreadPool {
+public:
+    explicit ThreadPool(std::size_t n_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Number of worker threads, not counting callers
+    std::size_t size() const;
+
+    // Runs f(0), ..., f(n - 1) across the workers and the calling thread, returning once all are done
+    // If any call throws, the first exception is rethrown here after the others have finished
+    void parallel_for(std::size_t n, const std::function<void(std::size_t)>& f);
+
+private:
+    void work();
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping = false;
+};
+
+}
+
+#endif
@@ -26,6 +26,12 @@ Transcript::Transcript(const std::string domain) {
     include_label(domain);
 }
 
+// Copy another transcript's state, so a shared prefix can be hashed once and reused
+Transcript::Transcript(const Transcript& t) {
+    this->ctx = EVP_MD_CTX_new();
+    EVP_MD_CTX_copy_ex(this->ctx, t.ctx);
+}
+
 Transcript::~Transcript() {
     EVP_MD_CTX_free(this->ctx);
 }
@@ -42,13 +48,12 @@ Transcript& Transcript::operator=(const Transcript& t) {
 
 // Add a group element
 void Transcript::add(const std::string label, const GroupElement& group_element) {
-    std::vector<unsigned char> data;
-    data.resize(GroupElement::serialize_size);
-    group_element.serialize(data.data());
+    unsigned char data[GroupElement::serialize_size];
+    group_element.serialize(data);
 
     include_flag(FLAG_DATA);
     include_label(label);
-    include_data(data);
+    include_data(data, sizeof(data));
 }
 
 // Add a vector of group elements
@@ -56,23 +61,37 @@ void Transcript::add(const std::string label, const std::vector<GroupElement>& g
     include_flag(FLAG_VECTOR);
     size(group_elements.size());
     include_label(label);
-    for (std::size_t i = 0; i < group_elements.size(); i++) {
-        std::vector<unsigned char> data;
-        data.resize(GroupElement::serialize_size);
-        group_elements[i].serialize(data.data());
-        include_data(data);
+
+    // Serialization needs affine points, so copy out only the elements that are not yet
+    // normalized and share one inversion across them
+    std::vector<GroupElement> normalized;
+    for (const GroupElement& group_element : group_elements) {
+        if (!group_element.isNormalized()) {
+            normalized.emplace_back(group_element);
+        }
+    }
+    GroupElement::batch_normalize(normalized);
+
+    unsigned char data[GroupElement::serialize_size];
+    std::size_t next = 0;
+    for (const GroupElement& group_element : group_elements) {
+        if (group_element.isNormalized()) {
+            group_element.serialize(data);
+        } else {
+            normalized[next++].serialize(data);
+        }
+        include_data(data, sizeof(data));
     }
 }
 
 // Add a scalar
 void Transcript::add(const std::string label, const Scalar& scalar) {
-    std::vector<unsigned char> data;
-    data.resize(SCALAR_ENCODING);
-    scalar.serialize(data.data());
+    unsigned char data[SCALAR_ENCODING];
+    scalar.serialize(data);
 
     include_flag(FLAG_DATA);
     include_label(label);
-    include_data(data);
+    include_data(data, sizeof(data));
 }
 
 // Add a vector of scalars
@@ -80,11 +99,10 @@ void Transcript::add(const std::string label, const std::vector<Scalar>& scalars
     include_flag(FLAG_VECTOR);
     size(scalars.size());
     include_label(label);
+    unsigned char data[SCALAR_ENCODING];
     for (std::size_t i = 0; i < scalars.size(); i++) {
-        std::vector<unsigned char> data;
-        data.resize(SCALAR_ENCODING);
-        scalars[i].serialize(data.data());
-        include_data(data);
+        scalars[i].serialize(data);
+        include_data(data, sizeof(data));
     }
 }
 
@@ -148,10 +166,9 @@ Scalar Transcript::challenge(const std::string label) {
 // Encode and include a size
 void Transcript::size(const std::size_t size_) {
     Scalar size_scalar(size_);
-    std::vector<unsigned char> size_data;
-    size_data.resize(SCALAR_ENCODING);
-    size_scalar.serialize(size_data.data());
-    EVP_DigestUpdate(this->ctx, size_data.data(), size_data.size());
+    unsigned char size_data[SCALAR_ENCODING];
+    size_scalar.serialize(size_data);
+    EVP_DigestUpdate(this->ctx, size_data, sizeof(size_data));
 }
 
 // Include a flag
@@ -161,17 +178,20 @@ void Transcript::include_flag(const unsigned char flag) {
 
 // Encode and include a label
 void Transcript::include_label(const std::string label) {
-    std::vector<unsigned char> bytes(label.begin(), label.end());
-    include_data(bytes);
+    include_data(reinterpret_cast<const unsigned char*>(label.data()), label.size());
 }
 
 // Encode and include data
 void Transcript::include_data(const std::vector<unsigned char>& data) {
+    include_data(data.data(), data.size());
+}
+
+void Transcript::include_data(const unsigned char* data, const std::size_t size_) {
     // Include size
-    size(data.size());
+    size(size_);
 
     // Include data
-    EVP_DigestUpdate(this->ctx, data.data(), data.size());
+    EVP_DigestUpdate(this->ctx, data, size_);
 }
 
 }
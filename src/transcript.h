@@ -10,6 +10,7 @@ using namespace secp_primitives;
 class Transcript {
 public:
     Transcript(const std::string);
+    Transcript(const Transcript&); // snapshot of the current state, which then evolves independently
     Transcript& operator=(const Transcript&);
     ~Transcript();
     void add(const std::string, const Scalar&);
@@ -24,6 +25,7 @@ private:
     void include_flag(const unsigned char);
     void include_label(const std::string);
     void include_data(const std::vector<unsigned char>&);
+    void include_data(const unsigned char*, const std::size_t);
     EVP_MD_CTX* ctx;
 };
 
@@ -41,25 +41,38 @@ uint64_t SparkUtils::diversifier_decrypt(const std::vector<unsigned char>& key,
         throw std::invalid_argument("Bad diversifier ciphertext size");
     }
 
+    // Decrypt using padded AES-256 (CBC) using a zero IV
     std::vector<unsigned char> iv;
     iv.resize(AES_BLOCKSIZE);
-
-    // Decrypt using padded AES-256 (CBC) using a zero IV, ensuring that the decrypted data is the expected length
     AES256CBCDecrypt aes(key.data(), iv.data(), true);
-    std::vector<unsigned char> plaintext;
-    plaintext.resize(AES_BLOCKSIZE);
-    int length = aes.Decrypt(d.data(), d.size(), plaintext.data());
-    if (length != sizeof(uint64_t)) {
+
+    uint64_t i;
+    if (!diversifier_decrypt(aes, d, i)) {
         throw std::runtime_error("Invalid diversifier length");
     }
 
+    return i;
+}
+
+// Decrypt a diversifier with an existing key schedule, returning false if the ciphertext is malformed
+bool SparkUtils::diversifier_decrypt(const AES256CBCDecrypt& aes, const std::vector<unsigned char>& d, uint64_t& i) {
+    if (d.size() != AES_BLOCKSIZE) {
+        return false;
+    }
+
+    // Ensure that the decrypted data is the expected length
+    unsigned char plaintext[AES_BLOCKSIZE];
+    int length = aes.Decrypt(d.data(), d.size(), plaintext);
+    if (length != sizeof(uint64_t)) {
+        return false;
+    }
+
     // Deserialize the diversifier
     CDataStream i_stream(SER_NETWORK, PROTOCOL_VERSION);
-    i_stream.write((const char *)plaintext.data(), sizeof(uint64_t));
-    uint64_t i;
+    i_stream.write((const char *)plaintext, sizeof(uint64_t));
     i_stream >> i;
 
-    return i;
+    return true;
 }
 
 // Produce a uniformly-sampled group element from a label
@@ -96,6 +96,7 @@ public:
     // Diversifier encryption/decryption
     static std::vector<unsigned char> diversifier_encrypt(const std::vector<unsigned char>& key, const uint64_t i);
     static uint64_t diversifier_decrypt(const std::vector<unsigned char>& key, const std::vector<unsigned char>& d);
+    static bool diversifier_decrypt(const AES256CBCDecrypt& aes, const std::vector<unsigned char>& d, uint64_t& i); // prepared key, non-throwing
 };
 
 }
@@ -247,6 +247,77 @@ BOOST_AUTO_TEST_CASE(completeness_batch)
     BOOST_CHECK(bpplus.verify(C, proofs));
 }
 
+// Generate and verify a batch of proofs using precomputed generator tables
+BOOST_AUTO_TEST_CASE(completeness_batch_tables)
+{
+    // Parameters
+    std::size_t N = 64; // bit length
+    std::vector<std::size_t> sizes = {1, 3, 4};
+
+    // Generators
+    GroupElement G, H;
+    G.randomize();
+    H.randomize();
+
+    std::vector<GroupElement> Gi, Hi;
+    Gi.resize(8*N);
+    Hi.resize(8*N);
+    for (std::size_t i = 0; i < 8*N; i++) {
+        Gi[i].randomize();
+        Hi[i].randomize();
+    }
+
+    FixedBaseExponent G_table(G), H_table(H);
+    FixedMultiExponent Gi_table(Gi), Hi_table(Hi);
+
+    // The generator tables must agree with a plain multiexponentiation, including on prefixes
+    std::vector<Scalar> powers(3*N);
+    for (std::size_t i = 0; i < powers.size(); i++) {
+        powers[i].randomize();
+    }
+    powers[0] = Scalar(uint64_t(1)).negate();
+    powers[1] = Scalar(uint64_t(0));
+    std::vector<GroupElement> prefix(Gi.begin(), Gi.begin() + powers.size());
+    BOOST_CHECK(Gi_table.get_multiple(powers) == MultiExponent(prefix, powers).get_multiple());
+
+    BPPlus bpplus(G_table, H_table, Gi, Hi, Gi_table, Hi_table, N);
+    BPPlus bpplus_plain(G, H, Gi, Hi, N);
+    std::vector<BPPlusProof> proofs;
+    proofs.resize(sizes.size());
+    std::vector<std::vector<GroupElement>> C;
+
+    // Build each proof
+    for (std::size_t i = 0; i < sizes.size(); i++) {
+        // Commitments
+        std::size_t M = sizes[i];
+        std::vector<Scalar> v, r;
+        v.resize(M);
+        r.resize(M);
+        std::vector<GroupElement> C_;
+        C_.resize(M);
+        for (std::size_t j = 0; j < M; j++) {
+            v[j] = Scalar(uint64_t(j));
+            r[j].randomize();
+            C_[j] = G*v[j] + H*r[j];
+        }
+        C.emplace_back(C_);
+
+        bpplus.prove(v, r, C_, proofs[i]);
+    }
+
+    BOOST_CHECK(bpplus.verify(C, proofs));
+    BOOST_CHECK(bpplus_plain.verify(C, proofs));
+
+    // Proofs processed in parallel
+    ThreadPool thread_pool(2);
+    BOOST_CHECK(bpplus.verify(C, proofs, &thread_pool));
+
+    // Break a proof
+    proofs.back().A1.randomize();
+    BOOST_CHECK(!bpplus.verify(C, proofs));
+    BOOST_CHECK(!bpplus.verify(C, proofs, &thread_pool));
+}
+
 // An invalid batch of proofs
 BOOST_AUTO_TEST_CASE(invalid_batch)
 {
@@ -300,6 +371,33 @@ BOOST_AUTO_TEST_CASE(invalid_batch)
     BOOST_CHECK(!bpplus.verify(C, proofs));
 }
 
+BOOST_AUTO_TEST_CASE(batch_invert)
+{
+    // Batch inversion must match single inversion and leave zero alone
+    for (std::size_t size : { 1, 5 }) {
+        std::vector<Scalar> scalars(size);
+        for (Scalar& scalar : scalars) {
+            scalar.randomize();
+        }
+        scalars[size / 2] = Scalar(uint64_t(0));
+        std::vector<Scalar> inverses(scalars);
+        Scalar::batch_invert(inverses);
+        for (std::size_t i = 0; i < size; i++) {
+            BOOST_CHECK_EQUAL(inverses[i], scalars[i].inverse());
+        }
+    }
+
+    // All zero and empty inputs are left as they are
+    std::vector<Scalar> zeros(3, Scalar(uint64_t(0)));
+    Scalar::batch_invert(zeros);
+    for (const Scalar& zero : zeros) {
+        BOOST_CHECK(zero.isZero());
+    }
+    std::vector<Scalar> empty;
+    Scalar::batch_invert(empty);
+    BOOST_CHECK(empty.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -1,4 +1,5 @@
 #include "../src/coin.h"
+#include "../src/coin_scan_view.h"
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
 #include <boost/test/unit_test.hpp>
@@ -119,6 +120,232 @@ BOOST_AUTO_TEST_CASE(spend_identify_recover)
     );
     BOOST_CHECK_EQUAL(r_data.T*r_data.s + full_view_key.get_D(), params->get_U());
 }
+
+BOOST_AUTO_TEST_CASE(batch_recover)
+{
+    // Parameters
+    const Params* params;
+    params = Params::get_default();
+
+    // Generate keys
+    SpendKey spend_key(params);
+    FullViewKey full_view_key(spend_key);
+    IncomingViewKey incoming_view_key(full_view_key);
+
+    // Generate coins to several diversifiers
+    std::vector<Coin> coins;
+    std::vector<IdentifiedCoinData> i_data;
+    for (uint64_t i = 0; i < 4; i++) {
+        Address address(incoming_view_key, i);
+        Scalar k;
+        k.randomize();
+        coins.emplace_back(Coin(params, COIN_TYPE_MINT, k, address, 100 + i, "", random_char_vector()));
+        i_data.emplace_back(coins.back().identify(incoming_view_key));
+    }
+
+    // The batch must match recovering each coin on its own
+    std::vector<RecoveredCoinData> r_data = Coin::recover(full_view_key, coins, i_data);
+    BOOST_CHECK_EQUAL(r_data.size(), coins.size());
+    for (std::size_t i = 0; i < coins.size(); i++) {
+        RecoveredCoinData expected = coins[i].recover(full_view_key, i_data[i]);
+        BOOST_CHECK_EQUAL(r_data[i].s, expected.s);
+        BOOST_CHECK_EQUAL(r_data[i].T, expected.T);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(try_identify)
+{
+    // Parameters
+    const Params* params;
+    params = Params::get_default();
+
+    const uint64_t i = 12345;
+    const uint64_t v = 86;
+    const std::string memo = "Spam and eggs";
+
+    // Generate keys for two wallets
+    SpendKey spend_key(params);
+    FullViewKey full_view_key(spend_key);
+    IncomingViewKey incoming_view_key(full_view_key);
+
+    SpendKey other_spend_key(params);
+    FullViewKey other_full_view_key(other_spend_key);
+    IncomingViewKey other_incoming_view_key(other_full_view_key);
+
+    // Generate coin
+    Address address(incoming_view_key, i);
+    Scalar k;
+    k.randomize();
+    Coin coin = Coin(
+        params,
+        COIN_TYPE_SPEND,
+        k,
+        address,
+        v,
+        memo,
+        random_char_vector()
+    );
+
+    // Identify with reused decryption state
+    AEADDecryptor decryptor;
+    std::optional<IdentifiedCoinData> i_data = coin.try_identify(incoming_view_key, decryptor);
+    BOOST_REQUIRE(i_data);
+    BOOST_CHECK_EQUAL(i_data->i, i);
+    BOOST_CHECK_EQUAL(i_data->v, v);
+    BOOST_CHECK_EQUAL(i_data->k, k);
+    BOOST_CHECK_EQUAL(i_data->memo, memo);
+
+    // Another wallet does not identify it
+    BOOST_CHECK(!coin.try_identify(other_incoming_view_key, decryptor));
+    BOOST_CHECK_THROW(coin.identify(other_incoming_view_key, decryptor), std::runtime_error);
+
+    // The decryption state is still usable after a failure
+    BOOST_CHECK(coin.try_identify(incoming_view_key, decryptor));
+
+    // Prepared keys identify the coin with or without its diversifier cached
+    for (const std::vector<uint64_t>& diversifiers : {std::vector<uint64_t>{}, std::vector<uint64_t>{0, i}}) {
+        PreparedIncomingViewKey prepared_key(incoming_view_key, diversifiers);
+        std::optional<IdentifiedCoinData> prepared_data = coin.try_identify(prepared_key, decryptor);
+        BOOST_REQUIRE(prepared_data);
+        BOOST_CHECK_EQUAL(prepared_data->i, i);
+        BOOST_CHECK_EQUAL(prepared_data->v, v);
+        BOOST_CHECK_EQUAL(prepared_data->k, k);
+        BOOST_CHECK_EQUAL(prepared_data->memo, memo);
+        BOOST_CHECK(!coin.try_identify(PreparedIncomingViewKey(other_incoming_view_key, diversifiers), decryptor));
+    }
+
+    // A coin with a bad value commitment decrypts but is rejected
+    Coin evil_coin(coin);
+    evil_coin.C.randomize();
+    BOOST_CHECK(!evil_coin.try_identify(incoming_view_key));
+    BOOST_CHECK(!evil_coin.try_identify(PreparedIncomingViewKey(incoming_view_key, {i}), decryptor));
+    BOOST_CHECK_THROW(evil_coin.identify(incoming_view_key), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(scan_view)
+{
+    // Parameters
+    const Params* params;
+    params = Params::get_default();
+
+    const uint64_t i = 12345;
+    const uint64_t v = 86;
+    const std::string memo = "Spam and eggs";
+
+    // Generate keys for two wallets
+    SpendKey spend_key(params);
+    FullViewKey full_view_key(spend_key);
+    IncomingViewKey incoming_view_key(full_view_key);
+    PreparedIncomingViewKey prepared_key(incoming_view_key, {i});
+
+    SpendKey other_spend_key(params);
+    FullViewKey other_full_view_key(other_spend_key);
+    IncomingViewKey other_incoming_view_key(other_full_view_key);
+    PreparedIncomingViewKey other_prepared_key(other_incoming_view_key);
+
+    Address address(incoming_view_key, i);
+    AEADDecryptor decryptor;
+    for (char type : {COIN_TYPE_MINT, COIN_TYPE_SPEND}) {
+        // Generate and serialize a coin
+        Scalar k;
+        k.randomize();
+        const std::vector<unsigned char> serial_context = random_char_vector();
+        Coin coin(params, type, k, address, v, memo, serial_context);
+        CDataStream stream(SER_NETWORK, PROTOCOL_VERSION);
+        stream << coin;
+        std::vector<unsigned char> serialized(stream.begin(), stream.end());
+
+        // Parse in place
+        CoinScanView view(serialized.data(), serialized.size());
+        BOOST_CHECK_EQUAL(view.get_type(), type);
+        BOOST_CHECK_EQUAL(view.get_K(), coin.K);
+        BOOST_CHECK_EQUAL(view.get_encoded_size(), serialized.size());
+        BOOST_CHECK(view.decode() == coin);
+
+        // Only the owner matches and identifies the coin
+        BOOST_CHECK(view.matches(incoming_view_key.get_s1(), decryptor));
+        BOOST_CHECK(!view.matches(other_incoming_view_key.get_s1(), decryptor));
+
+        Coin decoded;
+        std::optional<IdentifiedCoinData> i_data = view.try_identify(prepared_key, decryptor, serial_context, decoded);
+        BOOST_REQUIRE(i_data);
+        BOOST_CHECK_EQUAL(i_data->i, i);
+        BOOST_CHECK_EQUAL(i_data->v, v);
+        BOOST_CHECK_EQUAL(i_data->k, k);
+        BOOST_CHECK_EQUAL(i_data->memo, memo);
+        BOOST_CHECK(decoded == coin);
+        BOOST_CHECK(!view.try_identify(other_prepared_key, decryptor, serial_context, decoded));
+
+        // Validation still depends on the serial context
+        BOOST_CHECK(!view.try_identify(prepared_key, decryptor, random_char_vector(), decoded));
+
+        // A ciphertext that fails authentication is rejected even though its key commitment matches
+        std::vector<unsigned char> tampered(serialized);
+        tampered[1 + 3*GroupElement::serialize_size + 1] ^= 1;
+        CoinScanView tampered_view(tampered.data(), tampered.size());
+        BOOST_CHECK(tampered_view.matches(incoming_view_key.get_s1(), decryptor));
+        BOOST_CHECK(!tampered_view.try_identify(prepared_key, decryptor, serial_context, decoded));
+
+        // Truncated and mistyped encodings are rejected
+        BOOST_CHECK_THROW(CoinScanView(serialized.data(), serialized.size() - 1), std::invalid_argument);
+        std::vector<unsigned char> evil_serialized(serialized);
+        evil_serialized[0] = 2;
+        BOOST_CHECK_THROW(CoinScanView(evil_serialized.data(), evil_serialized.size()), std::invalid_argument);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(batch_identify)
+{
+    // Parameters
+    const Params* params;
+    params = Params::get_default();
+
+    const std::size_t N = 12;
+
+    // Generate keys for two wallets
+    SpendKey spend_key(params);
+    FullViewKey full_view_key(spend_key);
+    IncomingViewKey incoming_view_key(full_view_key);
+    PreparedIncomingViewKey prepared_key(incoming_view_key, {0, 1});
+
+    SpendKey other_spend_key(params);
+    FullViewKey other_full_view_key(other_spend_key);
+    IncomingViewKey other_incoming_view_key(other_full_view_key);
+
+    // Our coins over cached and uncached diversifiers, with some for the other wallet
+    std::vector<Coin> coins;
+    for (std::size_t j = 0; j < N; j++) {
+        Scalar k;
+        k.randomize();
+        Address address(j % 4 == 3 ? other_incoming_view_key : incoming_view_key, uint64_t(j % 3));
+        coins.emplace_back(Coin(params, j % 2 ? COIN_TYPE_MINT : COIN_TYPE_SPEND, k, address, uint64_t(j), "memo", random_char_vector()));
+    }
+
+    // All valid coins are identified together
+    AEADDecryptor decryptor;
+    std::vector<std::optional<IdentifiedCoinData>> i_data = Coin::try_identify(prepared_key, coins, decryptor);
+    BOOST_REQUIRE_EQUAL(i_data.size(), N);
+    for (std::size_t j = 0; j < N; j++) {
+        BOOST_CHECK_EQUAL(bool(i_data[j]), j % 4 != 3);
+        if (i_data[j]) {
+            BOOST_CHECK_EQUAL(i_data[j]->i, j % 3);
+            BOOST_CHECK_EQUAL(i_data[j]->v, j);
+        }
+    }
+
+    // Malformed coins are isolated by bisection
+    coins[1].C.randomize();
+    coins[6].S.randomize();
+    coins[8].serial_context = random_char_vector();
+    i_data = Coin::try_identify(prepared_key, coins, decryptor);
+    for (std::size_t j = 0; j < N; j++) {
+        BOOST_CHECK_EQUAL(bool(i_data[j]), j % 4 != 3 && j != 1 && j != 6 && j != 8);
+        BOOST_CHECK_EQUAL(bool(i_data[j]), bool(coins[j].try_identify(incoming_view_key)));
+    }
+
+    BOOST_CHECK(Coin::try_identify(prepared_key, std::vector<Coin>(), decryptor).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
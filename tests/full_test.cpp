@@ -82,6 +82,79 @@ BOOST_AUTO_TEST_CASE(generate_verify)
     std::vector<uint8_t> inputScript;
     std::vector<std::vector<unsigned char>> outputScripts;
     BOOST_CHECK_NO_THROW(getSparkSpendScripts(full_view_key, spend_key, inputs, cover_set_data, idAndBlockHashes, uint64_t(1), uint64_t(99), privOutputs, inputScript, outputScripts));
+
+    // On the calling thread alone, on a capped pool, and back to the default
+    for (std::size_t threads : {std::size_t(1), std::size_t(3), std::size_t(0)}) {
+        setSparkProverThreads(threads);
+        BOOST_CHECK_NO_THROW(getSparkSpendScripts(full_view_key, spend_key, inputs, cover_set_data, idAndBlockHashes, uint64_t(1), uint64_t(99), privOutputs, inputScript, outputScripts));
+        BOOST_CHECK(!inputScript.empty());
+        BOOST_CHECK_EQUAL(outputScripts.size(), privOutputs.size());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(identify_batch)
+{
+    auto* params = spark::Params::get_default();
+
+    Scalar r_;
+    r_.randomize();
+    SpendKey spend_key(params, r_);
+    FullViewKey full_view_key(spend_key);
+    IncomingViewKey incoming_view_key(full_view_key);
+
+    r_.randomize();
+    SpendKey other_spend_key(params, r_);
+    FullViewKey other_full_view_key(other_spend_key);
+    IncomingViewKey other_incoming_view_key(other_full_view_key);
+
+    // Spread our coins across several chunks among coins for another key
+    const std::size_t n_coins = 600;
+    std::vector<Coin> coins;
+    std::vector<uint64_t> values;
+    for (std::size_t j = 0; j < n_coins; j++) {
+        Scalar k;
+        k.randomize();
+        const bool ours = j % 7 == 3;
+        Address address(ours ? incoming_view_key : other_incoming_view_key, uint64_t(j % 5));
+        coins.emplace_back(Coin(params, j % 2 ? COIN_TYPE_MINT : COIN_TYPE_SPEND, k, address, uint64_t(j), "memo", random_char_vector()));
+        if (ours) {
+            values.emplace_back(j);
+        }
+    }
+
+    // Both without and with the wallet's diversifiers prepared
+    PreparedIncomingViewKey prepared_key(incoming_view_key, {0, 1, 2, 3, 4});
+    for (std::size_t threads : {std::size_t(1), std::size_t(3)}) {
+        for (bool prepared : {false, true}) {
+            std::vector<CSparkMintMeta> metas = prepared ? identifyCoins(coins, prepared_key, threads) : identifyCoins(coins, incoming_view_key, threads);
+            BOOST_REQUIRE_EQUAL(metas.size(), values.size());
+            for (std::size_t j = 0; j < metas.size(); j++) {
+                BOOST_CHECK_EQUAL(metas[j].v, values[j]);
+                BOOST_CHECK_EQUAL(metas[j].i, values[j] % 5);
+                BOOST_CHECK(metas[j] == getMetadata(metas[j].coin, incoming_view_key));
+            }
+        }
+
+        // The same coins in serialized form, with a malformed encoding mixed in
+        std::vector<std::vector<unsigned char>> serialized_coins, serial_contexts;
+        for (const Coin& coin : coins) {
+            CDataStream stream(SER_NETWORK, PROTOCOL_VERSION);
+            stream << coin;
+            serialized_coins.emplace_back(stream.begin(), stream.end());
+            serial_contexts.emplace_back(coin.serial_context);
+        }
+        serialized_coins[3].pop_back();
+        std::vector<CSparkMintMeta> metas = identifyCoins(serialized_coins, serial_contexts, prepared_key, threads);
+        BOOST_REQUIRE_EQUAL(metas.size(), values.size() - 1);
+        for (std::size_t j = 0; j < metas.size(); j++) {
+            BOOST_CHECK_EQUAL(metas[j].v, values[j + 1]);
+            BOOST_CHECK(metas[j].coin == coins[values[j + 1]]);
+            BOOST_CHECK(metas[j] == getMetadata(metas[j].coin, incoming_view_key));
+        }
+    }
+    BOOST_CHECK_THROW(identifyCoins({{}}, {}, prepared_key), std::invalid_argument);
+
+    BOOST_CHECK(identifyCoins({}, incoming_view_key).empty());
 }
 
 BOOST_AUTO_TEST_SUITE_END()
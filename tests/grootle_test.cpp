@@ -172,6 +172,153 @@ BOOST_AUTO_TEST_CASE(invalid_batch)
     BOOST_CHECK(!grootle.verify(S, S1, V, V1, roots, sizes, proofs));
 }
 
+BOOST_AUTO_TEST_CASE(multiple_sets)
+{
+    // Parameters
+    const std::size_t n = 4;
+    const std::size_t m = 3;
+
+    // Generators
+    GroupElement H;
+    H.randomize();
+    std::vector<GroupElement> Gi = random_group_vector(n*m);
+    std::vector<GroupElement> Hi = random_group_vector(n*m);
+
+    Grootle grootle(H, Gi, Hi, n, m);
+
+    // Distinct commitment sets, each with proofs of its own
+    std::vector<std::size_t> commit_sizes = { 60, 64, 17 };
+    std::vector<std::vector<GroupElement>> S_sets, V_sets;
+    std::vector<GrootleStatement> statements;
+    for (std::size_t commit_size : commit_sizes) {
+        S_sets.emplace_back(random_group_vector(commit_size));
+        V_sets.emplace_back(random_group_vector(commit_size));
+    }
+    for (std::size_t k = 0; k < commit_sizes.size(); k++) {
+        std::vector<GroupElement>& S = S_sets[k];
+        std::vector<GroupElement>& V = V_sets[k];
+
+        statements.emplace_back();
+        GrootleStatement& statement = statements.back();
+        statement.S = S.data();
+        statement.V = V.data();
+        statement.commits_size = commit_sizes[k];
+
+        // Generate valid commitments to zero
+        std::vector<std::size_t> indexes = { 0, commit_sizes[k] - 1 };
+        std::vector<Scalar> s, v;
+        for (std::size_t index : indexes) {
+            s.emplace_back();
+            v.emplace_back();
+            s.back().randomize();
+            v.back().randomize();
+
+            statement.S1.emplace_back(S[index]);
+            statement.V1.emplace_back(V[index]);
+            S[index] += H*s.back();
+            V[index] += H*v.back();
+
+            statement.roots.emplace_back(std::vector<unsigned char>(SCALAR_ENCODING, (unsigned char) k));
+            statement.sizes.emplace_back(commit_sizes[k]);
+        }
+
+        for (std::size_t i = 0; i < indexes.size(); i++) {
+            statement.proofs.emplace_back();
+            grootle.prove(indexes[i], s[i], S, statement.S1[i], v[i], V, statement.V1[i], statement.roots[i], statement.proofs.back());
+        }
+    }
+
+    BOOST_CHECK(grootle.verify(statements));
+
+    // A single invalid proof in any set fails the whole batch
+    statements[1].S1.back().randomize();
+    BOOST_CHECK(!grootle.verify(statements));
+}
+
+BOOST_AUTO_TEST_CASE(threaded_prove)
+{
+    // Parameters
+    const std::size_t n = 2;
+    const std::size_t m = 4;
+    const std::size_t N = (std::size_t) std::pow(n, m); // N = 16
+
+    // Generators
+    GroupElement H;
+    H.randomize();
+    std::vector<GroupElement> Gi = random_group_vector(n*m);
+    std::vector<GroupElement> Hi = random_group_vector(n*m);
+
+    // Commitments, with a valid commitment to zero
+    std::vector<GroupElement> S = random_group_vector(N);
+    std::vector<GroupElement> V = random_group_vector(N);
+    const std::size_t index = 5;
+    Scalar s, v;
+    s.randomize();
+    v.randomize();
+    GroupElement S1 = S[index];
+    GroupElement V1 = V[index];
+    S[index] += H*s;
+    V[index] += H*v;
+    std::vector<unsigned char> root(SCALAR_ENCODING, 1);
+
+    // Pool sizes whose digit groups do not divide m evenly
+    Grootle grootle(H, Gi, Hi, n, m);
+    for (std::size_t threads = 1; threads <= 6; threads++) {
+        ThreadPool thread_pool(threads);
+        GrootleProof proof;
+        grootle.prove(index, s, S, S1, v, V, V1, root, proof, &thread_pool);
+        BOOST_CHECK(grootle.verify(S, S1, V, V1, root, N, proof));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(threaded_multiexp)
+{
+    // Enough points to be split across threads
+    const std::size_t size = 4099;
+    std::vector<GroupElement> points = random_group_vector(size);
+    std::vector<Scalar> scalars(size);
+    for (std::size_t i = 0; i < size; i++) {
+        scalars[i].randomize();
+    }
+
+    secp_primitives::MultiExponent multiexp(points, scalars);
+    GroupElement expected = multiexp.get_multiple();
+    BOOST_CHECK(multiexp.get_multiple(2) == expected);
+    BOOST_CHECK(multiexp.get_multiple(4) == expected);
+    BOOST_CHECK(multiexp.get_multiple(64) == expected);
+
+    // Partial ranges sum to the full multiexponentiation
+    BOOST_CHECK_EQUAL(secp_primitives::MultiExponent::split_count(size, 64), 4);
+    BOOST_CHECK_EQUAL(secp_primitives::MultiExponent::split_count(10, 4), 1);
+    GroupElement sum = multiexp.get_partial_multiple(0, 1000);
+    sum += multiexp.get_partial_multiple(1000, 1000);
+    sum += multiexp.get_partial_multiple(1000, size);
+    BOOST_CHECK(sum == expected);
+    BOOST_CHECK_THROW(multiexp.get_partial_multiple(1, size + 1), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(shared_base_multiexp)
+{
+    // Sizes on both sides of the Pippenger threshold, with an infinity base
+    for (std::size_t size : { 5, 300 }) {
+        std::vector<GroupElement> points = random_group_vector(size);
+        points[1] = GroupElement();
+        std::vector<std::vector<Scalar>> scalars(3, std::vector<Scalar>(size));
+        for (auto& vector : scalars) {
+            for (std::size_t i = 0; i < size; i++) {
+                vector[i].randomize();
+            }
+        }
+        scalars[2][0] = Scalar(uint64_t(0));
+
+        std::vector<GroupElement> results = secp_primitives::MultiExponent::get_multiples(points, scalars);
+        BOOST_CHECK_EQUAL(results.size(), scalars.size());
+        for (std::size_t k = 0; k < scalars.size(); k++) {
+            BOOST_CHECK(results[k] == secp_primitives::MultiExponent(points, scalars[k]).get_multiple());
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -55,6 +55,36 @@ BOOST_AUTO_TEST_CASE(completeness)
     BOOST_CHECK(schnorr.verify(Y, proof));
 }
 
+BOOST_AUTO_TEST_CASE(completeness_fixed_base)
+{
+    GroupElement G;
+    G.randomize();
+    FixedBaseExponent G_table(G);
+
+    // The table must agree with generic multiplication, including edge scalars
+    std::vector<Scalar> scalars = { Scalar(uint64_t(0)), Scalar(uint64_t(1)), Scalar(uint64_t(15)), Scalar(uint64_t(1)).negate() };
+    for (std::size_t i = 0; i < 4; i++) {
+        Scalar scalar;
+        scalar.randomize();
+        scalars.emplace_back(scalar);
+    }
+    for (const Scalar& scalar : scalars) {
+        BOOST_CHECK(G_table.get_multiple(scalar) == G*scalar);
+    }
+
+    Scalar y;
+    y.randomize();
+    GroupElement Y = G*y;
+
+    SchnorrProof proof;
+
+    Schnorr schnorr(G_table);
+    schnorr.prove(y, Y, proof);
+
+    BOOST_CHECK(schnorr.verify(Y, proof));
+    BOOST_CHECK(Schnorr(G).verify(Y, proof));
+}
+
 BOOST_AUTO_TEST_CASE(completeness_aggregate)
 {
     const std::size_t n = 3;
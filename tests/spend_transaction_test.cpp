@@ -133,6 +133,59 @@ BOOST_AUTO_TEST_CASE(generate_verify)
     for (const auto set_data : cover_set_data)
         cover_sets[set_data.first] = set_data.second.cover_set;
     BOOST_CHECK(SpendTransaction::verify(transaction, cover_sets));
+
+    // Prove again with the inputs and their proofs split across a pool
+    ThreadPool thread_pool(3);
+    SpendTransaction threaded_transaction(
+        params,
+        full_view_key,
+        spend_key,
+        spend_coin_data,
+        cover_set_data,
+        f,
+        0,
+        out_coin_data,
+        &thread_pool
+    );
+    threaded_transaction.setCoverSets(cover_set_data);
+    BOOST_CHECK(SpendTransaction::verify(threaded_transaction, cover_sets));
+
+    // Verify using a cache that was populated from a partial set and must be extended
+    const uint64_t cover_set_id = 31415;
+    std::vector<SpendTransaction> transactions = { transaction };
+    CoverSetCache cover_set_cache;
+    cover_set_cache.get(cover_set_id, std::vector<Coin>(in_coins.begin(), in_coins.begin() + N/2));
+    BOOST_CHECK(SpendTransaction::verify(params, transactions, cover_sets, cover_set_cache));
+
+    std::shared_ptr<const CoverSetPoints> cover_set_points = cover_set_cache.get(cover_set_id, in_coins);
+    BOOST_CHECK_EQUAL(cover_set_points->S.size(), N);
+    for (std::size_t i = 0; i < N; i++) {
+        BOOST_CHECK(cover_set_points->S[i].isNormalized());
+        BOOST_CHECK(cover_set_points->S[i] == in_coins[i].S);
+        BOOST_CHECK(cover_set_points->C[i] == in_coins[i].C);
+    }
+
+    // Reuse the cached set
+    BOOST_CHECK(SpendTransaction::verify(params, transactions, cover_sets, cover_set_cache));
+
+    // Verify both transactions with their range and Grootle batches on the pool
+    std::vector<SpendTransaction> both_transactions = { transaction, threaded_transaction };
+    BOOST_CHECK(SpendTransaction::verify(params, both_transactions, cover_sets, cover_set_cache, &thread_pool));
+
+    // Cached sizes are found without the coins
+    BOOST_CHECK(cover_set_cache.find(cover_set_id, N) == cover_set_points);
+    BOOST_CHECK(cover_set_cache.find(cover_set_id, N/2) == cover_set_points);
+    BOOST_CHECK(!cover_set_cache.find(cover_set_id, N + 1));
+    BOOST_CHECK(!cover_set_cache.find(cover_set_id + 1, 1));
+
+    // Entries are not rechecked against the coins, so a set that changed (as in a reorganization) must be erased
+    std::vector<Coin> reordered(in_coins);
+    std::swap(reordered[0], reordered[1]);
+    CoverSetCache stale_cache;
+    stale_cache.get(cover_set_id, reordered);
+    BOOST_CHECK(!SpendTransaction::verify(params, transactions, cover_sets, stale_cache));
+    stale_cache.erase(cover_set_id);
+    BOOST_CHECK(SpendTransaction::verify(params, transactions, cover_sets, stale_cache));
 }
 
 BOOST_AUTO_TEST_SUITE_END()
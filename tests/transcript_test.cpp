@@ -173,6 +173,71 @@ BOOST_AUTO_TEST_CASE(converging)
     BOOST_CHECK_NE(transcript_1.challenge("x"), transcript_2.challenge("x"));
 }
 
+BOOST_AUTO_TEST_CASE(normalized_elements)
+{
+    // Affine and Jacobian representations of the same points must be interchangeable
+    std::vector<GroupElement> jacobian;
+    for (std::size_t i = 0; i < 8; i++) {
+        GroupElement element;
+        element.randomize();
+        jacobian.emplace_back(element + element);
+    }
+    jacobian.emplace_back(GroupElement());
+
+    std::vector<GroupElement> affine(jacobian);
+    GroupElement::batch_normalize(affine);
+
+    for (std::size_t i = 0; i < jacobian.size(); i++) {
+        BOOST_CHECK_EQUAL(affine[i].isNormalized(), !affine[i].isInfinity());
+        BOOST_CHECK(affine[i] == jacobian[i]);
+        BOOST_CHECK(GroupElement(jacobian[i]).normalize() == affine[i]);
+        BOOST_CHECK_EQUAL(affine[i].get_hash(), jacobian[i].get_hash());
+        BOOST_CHECK(affine[i].getvch() == jacobian[i].getvch());
+    }
+    BOOST_CHECK(affine[0] != jacobian[1]);
+
+    Transcript transcript_1("Spam");
+    Transcript transcript_2("Spam");
+    transcript_1.add("Elements", affine);
+    transcript_2.add("Elements", jacobian);
+
+    BOOST_CHECK_EQUAL(transcript_1.challenge("x"), transcript_2.challenge("x"));
+
+    // As must a vector mixing both
+    std::vector<GroupElement> mixed(affine);
+    for (std::size_t i = 0; i < mixed.size(); i += 3) {
+        mixed[i] = jacobian[i];
+    }
+    Transcript transcript_3("Spam");
+    Transcript transcript_4("Spam");
+    transcript_3.add("Elements", mixed);
+    transcript_4.add("Elements", affine);
+    BOOST_CHECK_EQUAL(transcript_3.challenge("x"), transcript_4.challenge("x"));
+}
+
+BOOST_AUTO_TEST_CASE(snapshot)
+{
+    GroupElement group;
+    group.randomize();
+
+    // A copied prefix matches a transcript built from scratch
+    Transcript prefix("Spam");
+    prefix.add("Group", group);
+
+    Transcript transcript_1(prefix);
+    Transcript transcript_2("Spam");
+    transcript_2.add("Group", group);
+    Scalar ch = transcript_1.challenge("x");
+    BOOST_CHECK_EQUAL(ch, transcript_2.challenge("x"));
+
+    // Copies evolve independently of the prefix and of each other
+    Transcript transcript_3(prefix);
+    transcript_3.add("Scalar", Scalar(uint64_t(1)));
+    Transcript transcript_4(prefix);
+    BOOST_CHECK_NE(transcript_3.challenge("x"), transcript_4.challenge("x"));
+    BOOST_CHECK_EQUAL(prefix.challenge("x"), ch);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }